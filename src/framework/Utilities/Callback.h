@@ -19,6 +19,8 @@
 #ifndef MANGOS_CALLBACK_H
 #define MANGOS_CALLBACK_H
 
+#include <functional>
+
 // defines to simplify multi param templates code and readablity
 #define TYPENAMES_1 typename T1
 #define TYPENAMES_2 TYPENAMES_1, typename T2
@@ -552,6 +554,27 @@ namespace MaNGOS
             {
             }
     };
+
+    // wraps any callable, the callable takes ownership of the result
+    class FunctionQueryCallback : public IQueryCallback
+    {
+        public:
+
+            typedef std::function<void (QueryResult*)> Function;
+
+            explicit FunctionQueryCallback(Function const& function) : m_function(function), m_result(nullptr)
+            {
+            }
+
+            void Execute() override { m_function(m_result); }
+            void SetResult(QueryResult* result) override { m_result = result; }
+            QueryResult* GetResult() override { return m_result; }
+
+        private:
+
+            Function m_function;
+            QueryResult* m_result;
+    };
 }
 
 #endif
@@ -21,6 +21,8 @@
 EventProcessor::EventProcessor()
 {
     m_time = 0;
+    m_events = nullptr;
+    m_lastEvent = nullptr;
     m_aborting = false;
 }
 
@@ -35,12 +37,14 @@ void EventProcessor::Update(uint32 p_time)
     m_time += p_time;
 
     // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    while (m_events && m_events->m_execTime <= m_time)
     {
         // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+        BasicEvent* Event = m_events;
+        m_events = Event->m_nextEvent;
+        if (!m_events)
+            m_lastEvent = nullptr;
+        Event->m_nextEvent = nullptr;
 
         if (!Event->to_Abort)
         {
@@ -64,25 +68,23 @@ void EventProcessor::KillAllEvents(bool force)
     m_aborting = true;
 
     // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    BasicEvent* Event = m_events;
+    m_events = nullptr;
+    m_lastEvent = nullptr;
+    while (Event)
     {
-        EventList::iterator i_old = i;
-        ++i;
+        BasicEvent* next = Event->m_nextEvent;
+        Event->m_nextEvent = nullptr;
 
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
-        {
-            delete i_old->second;
+        Event->to_Abort = true;
+        Event->Abort(m_time);
+        if (force || Event->IsDeletable())
+            delete Event;
+        else                                                // need per-element cleanup
+            AddEvent(Event, Event->m_execTime, false);
 
-            if (!force)                                     // need per-element cleanup
-                m_events.erase(i_old);
-        }
+        Event = next;
     }
-
-    // fast clear event list (in force case)
-    if (force)
-        m_events.clear();
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
@@ -91,7 +93,21 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
         Event->m_addTime = m_time;
 
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+
+    // behind all events with the same or an earlier execution time
+    BasicEvent** link = &m_events;
+    if (m_lastEvent && m_lastEvent->m_execTime <= e_time)
+        link = &m_lastEvent->m_nextEvent;
+    else
+    {
+        while (*link && (*link)->m_execTime <= e_time)
+            link = &(*link)->m_nextEvent;
+    }
+
+    Event->m_nextEvent = *link;
+    *link = Event;
+    if (!Event->m_nextEvent)
+        m_lastEvent = Event;
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset) const
@@ -21,16 +21,19 @@
 
 #include "Platform/Define.h"
 
-#include <map>
+#include <cstddef>
+#include <new>
 
 // Note. All times are in milliseconds here.
 
 class BasicEvent
 {
+        friend class EventProcessor;
+
     public:
 
         BasicEvent()
-            : to_Abort(false)
+            : to_Abort(false), m_nextEvent(nullptr)
         {
         }
 
@@ -53,10 +56,70 @@ class BasicEvent
         // these can be used for time offset control
         uint64 m_addTime;                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
+
+    private:
+        BasicEvent* m_nextEvent;                            // next event in the queue, filled by event handler
 };
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+/**
+ * Base for events scheduled often enough that their allocation matters.
+ *
+ * Memory of deleted events is kept in a per thread free list and reused for the next event
+ * of the same type, so the events are still created with new and deleted by the processor.
+ * The free lists only grow to the largest number of such events alive at once and are not
+ * released before the process ends.
+ */
+template<class T>
+class PooledEvent : public BasicEvent
+{
+    public:
+        static void* operator new(size_t size)
+        {
+            if (size == sizeof(T) && m_freeList)
+            {
+                FreeNode* node = m_freeList;
+                m_freeList = node->next;
+                return node;
+            }
+            return ::operator new(size);
+        }
 
+        static void operator delete(void* ptr, size_t size)
+        {
+            if (!ptr)
+                return;
+
+            // deleted derived events are not reused, their size does not match
+            if (size != sizeof(T))
+            {
+                ::operator delete(ptr);
+                return;
+            }
+
+            FreeNode* node = static_cast<FreeNode*>(ptr);
+            node->next = m_freeList;
+            m_freeList = node;
+        }
+
+    private:
+        struct FreeNode
+        {
+            FreeNode* next;
+        };
+
+        static thread_local FreeNode* m_freeList;
+};
+
+template<class T>
+thread_local typename PooledEvent<T>::FreeNode* PooledEvent<T>::m_freeList = nullptr;
+
+/**
+ * Queue of timed events, ordered by execution time.
+ *
+ * The events are linked through BasicEvent itself, so queueing an event needs no allocation.
+ * Events with the same execution time run in the order they were added. Most events are added
+ * behind all queued ones, which is done in constant time.
+ */
 class EventProcessor
 {
     public:
@@ -68,11 +131,13 @@ class EventProcessor
         void KillAllEvents(bool force);
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
         uint64 CalculateTime(uint64 t_offset) const;
+        bool Empty() const { return !m_events; }
 
     protected:
 
         uint64 m_time;
-        EventList m_events;
+        BasicEvent* m_events;                               // first event of the queue
+        BasicEvent* m_lastEvent;                            // last event of the queue
         bool m_aborting;
 };
 
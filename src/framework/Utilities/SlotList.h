@@ -0,0 +1,150 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_SLOTLIST_H
+#define MANGOS_SLOTLIST_H
+
+#include "Platform/Define.h"
+
+#include <cstddef>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+/**
+ * List of pointers in the order they were added, stored contiguously.
+ *
+ * Read-only walks use plain vector iterators and don't write to the list, so a list can be
+ * read from any thread while its owner doesn't change it. A loop whose body may add or remove
+ * elements of the list it walks (the current one included) must use a Walker instead, on the
+ * thread owning the list: removing elements moves the position of the walkers of the list.
+ */
+template<typename T>
+class SlotList
+{
+    public:
+        typedef typename std::vector<T>::const_iterator const_iterator;
+        typedef const_iterator iterator;
+        typedef typename std::vector<T>::const_reverse_iterator const_reverse_iterator;
+
+        /// Walk which stays valid while elements are added or removed, walkers of a list are nested.
+        /// Used as an iterator: for (List::Walker i(list); !i.AtEnd(); ++i) with *i the current element.
+        class Walker
+        {
+            public:
+                explicit Walker(SlotList const& list) : m_list(list), m_current(nullptr), m_next(0), m_outer(list.m_walkers)
+                {
+                    m_list.m_walkers = this;
+                    ++*this;
+                }
+                ~Walker() { m_list.m_walkers = m_outer; }
+
+                Walker(Walker const&) = delete;
+                Walker& operator=(Walker const&) = delete;
+
+                bool AtEnd() const { return !m_current; }
+                T operator*() const { return m_current; }
+
+                Walker& operator++()
+                {
+                    m_current = m_next < m_list.m_elements.size() ? m_list.m_elements[m_next++] : nullptr;
+                    return *this;
+                }
+
+                // continue with the first element
+                void Restart()
+                {
+                    m_next = 0;
+                    ++*this;
+                }
+
+            private:
+                friend class SlotList;
+
+                SlotList const& m_list;
+                T m_current;                                // kept even if removed from the list meanwhile
+                size_t m_next;                              // index of the element following m_current
+                Walker* m_outer;
+        };
+
+        SlotList() : m_walkers(nullptr) {}
+        SlotList(SlotList const& other) : m_elements(other.m_elements), m_walkers(nullptr) {}
+
+        SlotList& operator=(SlotList const& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                m_elements = other.m_elements;
+            }
+            return *this;
+        }
+
+        const_iterator begin() const { return m_elements.begin(); }
+        const_iterator end() const { return m_elements.end(); }
+        const_reverse_iterator rbegin() const { return m_elements.rbegin(); }
+        const_reverse_iterator rend() const { return m_elements.rend(); }
+
+        bool empty() const { return m_elements.empty(); }
+        size_t size() const { return m_elements.size(); }
+        T front() const { return m_elements.front(); }
+
+        void push_back(T element) { m_elements.push_back(element); }
+
+        // removes all occurrences, as std::list::remove
+        void remove(T element)
+        {
+            for (Walker* walker = m_walkers; walker; walker = walker->m_outer)
+                walker->m_next -= std::count(m_elements.begin(), m_elements.begin() + walker->m_next, element);
+
+            m_elements.erase(std::remove(m_elements.begin(), m_elements.end(), element), m_elements.end());
+        }
+
+        void clear()
+        {
+            for (Walker* walker = m_walkers; walker; walker = walker->m_outer)
+                walker->m_next = 0;
+
+            m_elements.clear();
+        }
+
+        // stable sort by insertion, cheap for nearly sorted lists; returns the number of positions
+        // elements were moved by. Must not be called while the list is walked.
+        template<typename Compare>
+        uint32 sort(Compare comp)
+        {
+            uint32 moves = 0;
+            for (size_t i = 1; i < m_elements.size(); ++i)
+            {
+                T element = m_elements[i];
+                size_t j = i;
+                for (; j > 0 && comp(element, m_elements[j - 1]); --j)
+                    m_elements[j] = m_elements[j - 1];
+
+                m_elements[j] = element;
+                moves += uint32(i - j);
+            }
+            return moves;
+        }
+
+    private:
+        std::vector<T> m_elements;
+        mutable Walker* m_walkers;                          // innermost walker, only set by walkers on the owning thread
+};
+
+#endif
@@ -44,6 +44,7 @@ class AggressorAI : public CreatureAI
         bool IsControllable() const override { return true; }
 
         void UpdateAI(const uint32) override;
+        bool IsLocalUpdate(const uint32) const override { return true; }  // no target selected out of combat
         static int Permissible(const Creature*);
 
     private:
@@ -288,6 +288,13 @@ class CreatureAI
          */
         virtual void UpdateAI(const uint32 /*uiDiff*/) {}
 
+        /**
+         * Check if the next UpdateAI call can't touch anything but the creature itself
+         * Note: Only asked for creatures out of combat, these may be updated by worker threads of the parallel cell update
+         * @param uiDiff Passed time the next UpdateAI call will get
+         */
+        virtual bool IsLocalUpdate(const uint32 /*uiDiff*/) const { return false; }
+
         ///== State checks =================================
 
         /**
@@ -188,10 +188,11 @@ void GuardianAI::EnterEvadeMode()
     m_creature->CombatStop(true);
 
     // Handle Evade events
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    if (HasEvents(EVENT_T_EVADE))
     {
-        if (i->Event.event_type == EVENT_T_EVADE)
-            ProcessEvent(*i);
+        WakeUpEvents();
+        for (CreatureEventAIHolderList::const_iterator i = EventsBegin(EVENT_T_EVADE); i != EventsEnd(EVENT_T_EVADE); ++i)
+            ProcessEvent(**i);
     }
 }
 
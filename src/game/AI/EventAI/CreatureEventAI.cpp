@@ -62,6 +62,8 @@ void CreatureEventAI::GetAIInformation(ChatHandler& reader)
     if (sLog.HasLogFilter(LOG_FILTER_EVENT_AI_DEV))         // Give some more details if in EventAI Dev Mode
         return;
 
+    WakeUpEvents();
+
     reader.PSendSysMessage("Current events of this creature:");
     for (CreatureEventAIList::const_iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
     {
@@ -82,10 +84,11 @@ inline bool IsEventFlagsFitForNormalMap(uint8 eFlags)
 }
 
 CreatureEventAI::CreatureEventAI(Creature* c) : CreatureAI(c),
+    m_EventSleepTime(0),
+    m_EventSleepDiff(0),
     m_Phase(0),
     m_MeleeEnabled(true),
     m_DynamicMovement(false),
-    m_HasOOCLoSEvent(false),
     m_InvinceabilityHpLevel(0),
     m_throwAIEventMask(0),
     m_throwAIEventStep(0),
@@ -139,12 +142,7 @@ CreatureEventAI::CreatureEventAI(Creature* c) : CreatureAI(c),
                     storeEvent = true;
 
                 if (storeEvent)
-                {
                     m_CreatureEventAIList.push_back(CreatureEventAIHolder(*i));
-                    // Cache for fast use
-                    if (i->event_type == EVENT_T_OOC_LOS)
-                        m_HasOOCLoSEvent = true;
-                }
             }
         }
     }
@@ -157,6 +155,19 @@ CreatureEventAI::CreatureEventAI(Creature* c) : CreatureAI(c),
                 m_creature->GetEntry(), m_creature->GetGuidStr().c_str(), aiName.c_str());
         }
     }
+
+    // Group the events by type, so hooks only walk the events they handle (the list is not changed after this point)
+    memset(m_EventTypeIndex, 0, sizeof(m_EventTypeIndex));
+    for (CreatureEventAIList::const_iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+        ++m_EventTypeIndex[i->Event.event_type + 1];
+    for (uint32 type = 0; type < EVENT_T_END; ++type)
+        m_EventTypeIndex[type + 1] += m_EventTypeIndex[type];
+
+    uint16 nextIndex[EVENT_T_END];
+    memcpy(nextIndex, m_EventTypeIndex, sizeof(nextIndex));
+    m_EventsByType.resize(m_CreatureEventAIList.size());
+    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+        m_EventsByType[nextIndex[i->Event.event_type]++] = &*i;
 }
 
 bool CreatureEventAI::IsTimerBasedEvent(EventAI_Type type) const
@@ -185,6 +196,64 @@ bool CreatureEventAI::IsTimerBasedEvent(EventAI_Type type) const
     }
 }
 
+// Timer based events which can not trigger while out of combat
+bool CreatureEventAI::IsCombatOnlyEvent(EventAI_Type type) const
+{
+    switch (type)
+    {
+        case EVENT_T_TIMER_IN_COMBAT:
+        case EVENT_T_MANA:
+        case EVENT_T_HP:
+        case EVENT_T_TARGET_HP:
+        case EVENT_T_TARGET_CASTING:
+        case EVENT_T_FRIENDLY_IS_CC:
+        case EVENT_T_AURA:
+        case EVENT_T_TARGET_AURA:
+        case EVENT_T_MISSING_AURA:
+        case EVENT_T_TARGET_MISSING_AURA:
+        case EVENT_T_RANGE:
+        case EVENT_T_ENERGY:
+            return true;
+        default:                                            // EVENT_T_FRIENDLY_HP also triggers out of combat for guardians
+            return false;
+    }
+}
+
+uint32 CreatureEventAI::GetEventSleepTime() const
+{
+    if (m_creature->isInCombat())
+        return 0;
+
+    uint32 sleepTime = std::numeric_limits<uint32>::max();
+    for (CreatureEventAIList::const_iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    {
+        // Timers of events which cannot trigger in this phase are not decremented, the phase only changes by processing events
+        if (i->Event.event_inverse_phase_mask & (1 << m_Phase))
+            continue;
+
+        if (i->Time)
+            sleepTime = std::min(sleepTime, i->Time);
+        else if (i->Enabled && IsTimerBasedEvent(i->Event.event_type) && !IsCombatOnlyEvent(i->Event.event_type))
+            return 0;
+    }
+
+    return sleepTime;
+}
+
+void CreatureEventAI::WakeUpEvents()
+{
+    if (!m_EventSleepTime)
+        return;
+
+    // No timer expired while sleeping, only apply the passed time before events change them
+    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+        if (i->Time && !(i->Event.event_inverse_phase_mask & (1 << m_Phase)))
+            i->Time -= std::min(i->Time, m_EventSleepDiff);
+
+    m_EventSleepTime = 0;
+    m_EventSleepDiff = 0;
+}
+
 bool CreatureEventAI::ProcessEvent(CreatureEventAIHolder& pHolder, Unit* pActionInvoker, Creature* pAIEventSender /*=nullptr*/)
 {
     if (!pHolder.Enabled || pHolder.Time)
@@ -1114,6 +1183,7 @@ void CreatureEventAI::JustRespawned()                       // NOTE that this is
     m_EventDiff = 0;
     m_throwAIEventStep = 0;
     m_LastSpellMaxRange = 0;
+    WakeUpEvents();
 
     for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
     {
@@ -1145,6 +1215,7 @@ void CreatureEventAI::Reset()
     m_EventDiff = 0;
     m_throwAIEventStep = 0;
     m_LastSpellMaxRange = 0;
+    WakeUpEvents();
 
     // Reset all events to enabled
     for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
@@ -1171,10 +1242,11 @@ void CreatureEventAI::Reset()
 
 void CreatureEventAI::JustReachedHome()
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    if (HasEvents(EVENT_T_REACHED_HOME))
     {
-        if (i->Event.event_type == EVENT_T_REACHED_HOME)
-            ProcessEvent(*i);
+        WakeUpEvents();
+        for (CreatureEventAIHolderList::const_iterator i = EventsBegin(EVENT_T_REACHED_HOME); i != EventsEnd(EVENT_T_REACHED_HOME); ++i)
+            ProcessEvent(**i);
     }
 
     Reset();
@@ -1193,10 +1265,11 @@ void CreatureEventAI::EnterEvadeMode()
     m_creature->SetLootRecipient(nullptr);
 
     // Handle Evade events
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    if (HasEvents(EVENT_T_EVADE))
     {
-        if (i->Event.event_type == EVENT_T_EVADE)
-            ProcessEvent(*i);
+        WakeUpEvents();
+        for (CreatureEventAIHolderList::const_iterator i = EventsBegin(EVENT_T_EVADE); i != EventsEnd(EVENT_T_EVADE); ++i)
+            ProcessEvent(**i);
     }
 }
 
@@ -1215,10 +1288,11 @@ void CreatureEventAI::JustDied(Unit* killer)
         SendAIEventAround(AI_EVENT_JUST_DIED, killer, 0, AIEVENT_DEFAULT_THROW_RADIUS);
 
     // Handle On Death events
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    if (HasEvents(EVENT_T_DEATH))
     {
-        if (i->Event.event_type == EVENT_T_DEATH)
-            ProcessEvent(*i, killer);
+        WakeUpEvents();
+        for (CreatureEventAIHolderList::const_iterator i = EventsBegin(EVENT_T_DEATH); i != EventsEnd(EVENT_T_DEATH); ++i)
+            ProcessEvent(**i, killer);
     }
 
     // reset phase after any death state events
@@ -1230,37 +1304,41 @@ void CreatureEventAI::KilledUnit(Unit* victim)
     if (victim->GetTypeId() != TYPEID_PLAYER)
         return;
 
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    if (HasEvents(EVENT_T_KILL))
     {
-        if (i->Event.event_type == EVENT_T_KILL)
-            ProcessEvent(*i, victim);
+        WakeUpEvents();
+        for (CreatureEventAIHolderList::const_iterator i = EventsBegin(EVENT_T_KILL); i != EventsEnd(EVENT_T_KILL); ++i)
+            ProcessEvent(**i, victim);
     }
 }
 
 void CreatureEventAI::JustSummoned(Creature* pUnit)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    if (HasEvents(EVENT_T_SUMMONED_UNIT))
     {
-        if (i->Event.event_type == EVENT_T_SUMMONED_UNIT)
-            ProcessEvent(*i, pUnit);
+        WakeUpEvents();
+        for (CreatureEventAIHolderList::const_iterator i = EventsBegin(EVENT_T_SUMMONED_UNIT); i != EventsEnd(EVENT_T_SUMMONED_UNIT); ++i)
+            ProcessEvent(**i, pUnit);
     }
 }
 
 void CreatureEventAI::SummonedCreatureJustDied(Creature* pUnit)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    if (HasEvents(EVENT_T_SUMMONED_JUST_DIED))
     {
-        if (i->Event.event_type == EVENT_T_SUMMONED_JUST_DIED)
-            ProcessEvent(*i, pUnit);
+        WakeUpEvents();
+        for (CreatureEventAIHolderList::const_iterator i = EventsBegin(EVENT_T_SUMMONED_JUST_DIED); i != EventsEnd(EVENT_T_SUMMONED_JUST_DIED); ++i)
+            ProcessEvent(**i, pUnit);
     }
 }
 
 void CreatureEventAI::SummonedCreatureDespawn(Creature* pUnit)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    if (HasEvents(EVENT_T_SUMMONED_JUST_DESPAWN))
     {
-        if (i->Event.event_type == EVENT_T_SUMMONED_JUST_DESPAWN)
-            ProcessEvent(*i, pUnit);
+        WakeUpEvents();
+        for (CreatureEventAIHolderList::const_iterator i = EventsBegin(EVENT_T_SUMMONED_JUST_DESPAWN); i != EventsEnd(EVENT_T_SUMMONED_JUST_DESPAWN); ++i)
+            ProcessEvent(**i, pUnit);
     }
 }
 
@@ -1268,16 +1346,21 @@ void CreatureEventAI::ReceiveAIEvent(AIEventType eventType, Creature* pSender, U
 {
     MANGOS_ASSERT(pSender);
 
-    for (CreatureEventAIList::iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+    for (CreatureEventAIHolderList::const_iterator itr = EventsBegin(EVENT_T_RECEIVE_AI_EVENT); itr != EventsEnd(EVENT_T_RECEIVE_AI_EVENT); ++itr)
     {
-        if (itr->Event.event_type == EVENT_T_RECEIVE_AI_EVENT &&
-                itr->Event.receiveAIEvent.eventType == eventType && (!itr->Event.receiveAIEvent.senderEntry || itr->Event.receiveAIEvent.senderEntry == pSender->GetEntry()))
-            ProcessEvent(*itr, pInvoker, pSender);
+        CreatureEventAIHolder& holder = **itr;
+        if (holder.Event.receiveAIEvent.eventType == eventType && (!holder.Event.receiveAIEvent.senderEntry || holder.Event.receiveAIEvent.senderEntry == pSender->GetEntry()))
+        {
+            WakeUpEvents();
+            ProcessEvent(holder, pInvoker, pSender);
+        }
     }
 }
 
 void CreatureEventAI::EnterCombat(Unit* enemy)
 {
+    WakeUpEvents();
+
     // Check for on combat start events
     for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
     {
@@ -1328,22 +1411,24 @@ void CreatureEventAI::MoveInLineOfSight(Unit* who)
         return;
 
     // Check for OOC LOS Event
-    if (m_HasOOCLoSEvent && !m_creature->getVictim())
+    if (HasEvents(EVENT_T_OOC_LOS) && !m_creature->getVictim())
     {
-        for (CreatureEventAIList::iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+        for (CreatureEventAIHolderList::const_iterator itr = EventsBegin(EVENT_T_OOC_LOS); itr != EventsEnd(EVENT_T_OOC_LOS); ++itr)
         {
-            if (itr->Event.event_type == EVENT_T_OOC_LOS)
-            {
-                // can trigger if closer than fMaxAllowedRange
-                float fMaxAllowedRange = (float)itr->Event.ooc_los.maxRange;
+            CreatureEventAIHolder& holder = **itr;
+
+            // can trigger if closer than fMaxAllowedRange
+            float fMaxAllowedRange = (float)holder.Event.ooc_los.maxRange;
 
-                // if friendly event && who is not hostile OR hostile event && who is hostile
-                if ((itr->Event.ooc_los.noHostile && !m_creature->IsHostileTo(who)) ||
-                        ((!itr->Event.ooc_los.noHostile) && m_creature->IsHostileTo(who)))
+            // if friendly event && who is not hostile OR hostile event && who is hostile
+            if ((holder.Event.ooc_los.noHostile && !m_creature->IsHostileTo(who)) ||
+                    ((!holder.Event.ooc_los.noHostile) && m_creature->IsHostileTo(who)))
+            {
+                // if range is ok and we are actually in LOS
+                if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
                 {
-                    // if range is ok and we are actually in LOS
-                    if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
-                        ProcessEvent(*itr, who);
+                    WakeUpEvents();
+                    ProcessEvent(holder, who);
                 }
             }
         }
@@ -1374,12 +1459,19 @@ void CreatureEventAI::MoveInLineOfSight(Unit* who)
 
 void CreatureEventAI::SpellHit(Unit* pUnit, const SpellEntry* pSpell)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-        if (i->Event.event_type == EVENT_T_SPELLHIT)
-            // If spell id matches (or no spell id) & if spell school matches (or no spell school)
-            if (!i->Event.spell_hit.spellId || pSpell->Id == i->Event.spell_hit.spellId)
-                if (pSpell->SchoolMask & i->Event.spell_hit.schoolMask)
-                    ProcessEvent(*i, pUnit);
+    for (CreatureEventAIHolderList::const_iterator i = EventsBegin(EVENT_T_SPELLHIT); i != EventsEnd(EVENT_T_SPELLHIT); ++i)
+    {
+        CreatureEventAIHolder& holder = **i;
+        // If spell id matches (or no spell id) & if spell school matches (or no spell school)
+        if (!holder.Event.spell_hit.spellId || pSpell->Id == holder.Event.spell_hit.spellId)
+        {
+            if (pSpell->SchoolMask & holder.Event.spell_hit.schoolMask)
+            {
+                WakeUpEvents();
+                ProcessEvent(holder, pUnit);
+            }
+        }
+    }
 }
 
 void CreatureEventAI::UpdateAI(const uint32 diff)
@@ -1392,28 +1484,40 @@ void CreatureEventAI::UpdateAI(const uint32 diff)
     {
         m_EventDiff += diff;
 
-        // Check for time based events
-        for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+        // Out of combat nothing can trigger before the first running timer expires, only keep the passed time
+        if (m_EventSleepTime && !m_creature->isInCombat() && m_EventSleepDiff + m_EventDiff < m_EventSleepTime)
+            m_EventSleepDiff += m_EventDiff;
+        else
         {
-            // Decrement Timers
-            if (i->Time)
+            m_EventDiff += m_EventSleepDiff;
+            m_EventSleepTime = 0;
+            m_EventSleepDiff = 0;
+
+            // Check for time based events
+            for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
             {
-                // Do not decrement timers if event cannot trigger in this phase
-                if (!(i->Event.event_inverse_phase_mask & (1 << m_Phase)))
+                // Decrement Timers
+                if (i->Time)
                 {
-                    if (i->Time > m_EventDiff)
-                        i->Time -= m_EventDiff;
-                    else
-                        i->Time = 0;
+                    // Do not decrement timers if event cannot trigger in this phase
+                    if (!(i->Event.event_inverse_phase_mask & (1 << m_Phase)))
+                    {
+                        if (i->Time > m_EventDiff)
+                            i->Time -= m_EventDiff;
+                        else
+                            i->Time = 0;
+                    }
                 }
-            }
 
-            // Skip processing of events that have time remaining or are disabled
-            if (!(i->Enabled) || i->Time)
-                continue;
+                // Skip processing of events that have time remaining or are disabled
+                if (!(i->Enabled) || i->Time)
+                    continue;
 
-            if (IsTimerBasedEvent(i->Event.event_type))
-                ProcessEvent(*i);
+                if (IsTimerBasedEvent(i->Event.event_type))
+                    ProcessEvent(*i);
+            }
+
+            m_EventSleepTime = GetEventSleepTime();
         }
 
         m_EventDiff = 0;
@@ -1448,6 +1552,12 @@ void CreatureEventAI::UpdateAI(const uint32 diff)
     }
 }
 
+bool CreatureEventAI::IsLocalUpdate(const uint32 diff) const
+{
+    // no event is processed before the next event update or while sleeping
+    return m_EventUpdateTime >= diff || (m_EventSleepTime && m_EventSleepDiff + m_EventDiff + diff < m_EventSleepTime);
+}
+
 bool CreatureEventAI::IsVisible(Unit* pl) const
 {
     return m_creature->IsWithinDist(pl, sWorld.getConfig(CONFIG_FLOAT_SIGHT_MONSTER))
@@ -1585,19 +1695,18 @@ void CreatureEventAI::DoFindFriendlyMissingBuff(std::list<Creature*>& _list, flo
 
 void CreatureEventAI::ReceiveEmote(Player* pPlayer, uint32 text_emote)
 {
-    for (CreatureEventAIList::iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+    for (CreatureEventAIHolderList::const_iterator itr = EventsBegin(EVENT_T_RECEIVE_EMOTE); itr != EventsEnd(EVENT_T_RECEIVE_EMOTE); ++itr)
     {
-        if (itr->Event.event_type == EVENT_T_RECEIVE_EMOTE)
-        {
-            if (itr->Event.receive_emote.emoteId != text_emote)
-                continue;
+        CreatureEventAIHolder& holder = **itr;
+        if (holder.Event.receive_emote.emoteId != text_emote)
+            continue;
 
-            PlayerCondition pcon(0, itr->Event.receive_emote.condition, itr->Event.receive_emote.conditionValue1, itr->Event.receive_emote.conditionValue2);
-            if (pcon.Meets(pPlayer, m_creature->GetMap(), m_creature, CONDITION_FROM_EVENTAI))
-            {
-                DEBUG_FILTER_LOG(LOG_FILTER_AI_AND_MOVEGENSS, "CreatureEventAI: ReceiveEmote CreatureEventAI: Condition ok, processing");
-                ProcessEvent(*itr, pPlayer);
-            }
+        PlayerCondition pcon(0, holder.Event.receive_emote.condition, holder.Event.receive_emote.conditionValue1, holder.Event.receive_emote.conditionValue2);
+        if (pcon.Meets(pPlayer, m_creature->GetMap(), m_creature, CONDITION_FROM_EVENTAI))
+        {
+            DEBUG_FILTER_LOG(LOG_FILTER_AI_AND_MOVEGENSS, "CreatureEventAI: ReceiveEmote CreatureEventAI: Condition ok, processing");
+            WakeUpEvents();
+            ProcessEvent(holder, pPlayer);
         }
     }
 }
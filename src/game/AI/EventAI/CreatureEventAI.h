@@ -695,6 +695,7 @@ class CreatureEventAI : public CreatureAI
         void DamageTaken(Unit* done_by, uint32& damage, DamageEffectType damagetype) override;
         void HealedBy(Unit* healer, uint32& healedAmount) override;
         void UpdateAI(const uint32 diff) override;
+        bool IsLocalUpdate(const uint32 diff) const override;
         bool IsVisible(Unit*) const override;
         void ReceiveEmote(Player* pPlayer, uint32 text_emote) override;
         void SummonedCreatureJustDied(Creature* unit) override;
@@ -718,19 +719,34 @@ class CreatureEventAI : public CreatureAI
         void DoFindFriendlyCC(std::list<Creature*>& _list, float range) const;
 
     protected:
+        typedef std::vector<CreatureEventAIHolder*> CreatureEventAIHolderList;
+
         bool IsTimerBasedEvent(EventAI_Type type) const;
+        bool IsCombatOnlyEvent(EventAI_Type type) const;
+
+        // Events of one type, in the order of m_CreatureEventAIList
+        bool HasEvents(EventAI_Type type) const { return m_EventTypeIndex[type] != m_EventTypeIndex[type + 1]; }
+        CreatureEventAIHolderList::const_iterator EventsBegin(EventAI_Type type) const { return m_EventsByType.begin() + m_EventTypeIndex[type]; }
+        CreatureEventAIHolderList::const_iterator EventsEnd(EventAI_Type type) const { return m_EventsByType.begin() + m_EventTypeIndex[type + 1]; }
+
+        // Out of combat the event updates sleep until the first running timer expires
+        uint32 GetEventSleepTime() const;
+        void WakeUpEvents();
 
         uint32 m_EventUpdateTime;                           // Time between event updates
         uint32 m_EventDiff;                                 // Time between the last event call
+        uint32 m_EventSleepTime;                            // Time until the first running timer expires, 0 while the event updates are awake
+        uint32 m_EventSleepDiff;                            // Time passed while sleeping, not yet applied to the timers
 
         // Variables used by Events themselves
         typedef std::vector<CreatureEventAIHolder> CreatureEventAIList;
         CreatureEventAIList m_CreatureEventAIList;  // Holder for events (stores enabled, time, and eventid)
+        CreatureEventAIHolderList m_EventsByType;           // Holders of m_CreatureEventAIList grouped by event type
+        uint16 m_EventTypeIndex[EVENT_T_END + 1];           // First entry of each event type in m_EventsByType
 
         uint8  m_Phase;                                     // Current phase, max 32 phases
         bool   m_MeleeEnabled;                              // If we allow melee auto attack
         bool   m_DynamicMovement;                           // Core will control creatures movement if this is enabled
-        bool   m_HasOOCLoSEvent;                            // Cache if a OOC-LoS Event exists
         uint32 m_InvinceabilityHpLevel;                     // Minimal health level allowed at damage apply
 
         uint32 m_throwAIEventMask;                          // Automatically throw AIEvents that are encoded into this mask
@@ -177,7 +177,7 @@ struct boss_hodirAI : public ScriptedAI
             {
                 // Inform the faction helpers that the fight is over
                 ThreatList const& threatList = m_creature->getThreatManager().getThreatList();
-                for (ThreatList::const_iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
+                for (ThreatList::Walker itr(threatList); !itr.AtEnd(); ++itr)
                 {
                     // only check creatures
                     if (!(*itr)->getUnitGuid().IsCreature())
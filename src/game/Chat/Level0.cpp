@@ -26,6 +26,7 @@
 #include "Tools/Language.h"
 #include "Accounts/AccountMgr.h"
 #include "AI/ScriptDevAI/ScriptDevAIMgr.h"
+#include "Network/Socket.hpp"
 #include "SystemConfig.h"
 #include "revision.h"
 #include "Util.h"
@@ -106,6 +107,15 @@ bool ChatHandler::HandleServerInfoCommand(char* /*args*/)
     PSendSysMessage(LANG_CONNECTED_USERS, activeClientsNum, maxActiveClientsNum, queuedClientsNum, maxQueuedClientsNum);
     PSendSysMessage(LANG_UPTIME, str.c_str());
 
+    if (GetAccessLevel() >= SEC_ADMINISTRATOR)
+    {
+        MaNGOS::Socket::WriteStatistics stats = MaNGOS::Socket::GetWriteStatistics();
+        PSendSysMessage("Network: %.2f ms average send delay, %.0f bytes per send, %.2f sends per flush",
+                        stats.flushes ? double(stats.flushDelay) / stats.flushes / IN_MILLISECONDS : 0.0,
+                        stats.sends ? double(stats.bytesSent) / stats.sends : 0.0,
+                        stats.flushes ? double(stats.sends) / stats.flushes : 0.0);
+    }
+
     return true;
 }
 
@@ -6589,6 +6589,13 @@ bool ChatHandler::HandleInstanceStatsCommand(char* /*args*/)
     PSendSysMessage("instance saves: %d", numSaves);
     PSendSysMessage("players bound: %d", numBoundPlayers);
     PSendSysMessage("groups bound: %d", numBoundGroups);
+
+    PSendSysMessage("map update threads: %u", sMapMgr.GetNumMapUpdateThreads());
+    std::vector<Map*> maps;
+    sMapMgr.GetLongestMapUpdates(maps, 5);
+    for (std::vector<Map*>::const_iterator itr = maps.begin(); itr != maps.end(); ++itr)
+        PSendSysMessage("map %u (%s) instance %u: %u us average update, %u us last update, %u players", (*itr)->GetId(), (*itr)->GetMapName(),
+                        (*itr)->GetInstanceId(), (*itr)->GetAverageUpdateTime(), (*itr)->GetLastUpdateTime(), (*itr)->GetPlayers().getSize());
     return true;
 }
 
@@ -271,20 +271,22 @@ void ThreatContainer::modifyThreatPercent(Unit* pVictim, int32 pPercent)
 
 bool HostileReferenceSortPredicate(const HostileReference* lhs, const HostileReference* rhs)
 {
-    // std::list::sort ordering predicate must be: (Pred(x,y)&&Pred(y,x))==false
+    // stable sort ordering predicate must be: (Pred(x,y)&&Pred(y,x))==false
     return lhs->getThreat() > rhs->getThreat();             // reverse sorting
 }
 
 //============================================================
 // Check if the list is dirty and sort if necessary
+// The list is still sorted from the last update, so only references with changed threat move
 
-void ThreatContainer::update()
+uint32 ThreatContainer::update()
 {
+    uint32 moves = 0;
     if (iDirty && iThreatList.size() > 1)
-    {
-        iThreatList.sort(HostileReferenceSortPredicate);
-    }
+        moves = iThreatList.sort(HostileReferenceSortPredicate);
+
     iDirty = false;
+    return moves;
 }
 
 //============================================================
@@ -293,6 +295,9 @@ void ThreatContainer::update()
 
 HostileReference* ThreatContainer::selectNextVictim(Creature* pAttacker, HostileReference* pCurrentVictim)
 {
+    if (iThreatList.empty())
+        return nullptr;
+
     HostileReference* pCurrentRef = nullptr;
     bool found = false;
     bool onlySecondChoiceTargetsFound = false;
@@ -484,7 +489,19 @@ void ThreatManager::modifyThreatPercent(Unit* pVictim, int32 pPercent)
 
 Unit* ThreatManager::getHostileTarget()
 {
-    iThreatContainer.update();
+    // always bring the list back in order on the owner's thread before selecting a victim
+    bool sorted = iThreatContainer.isDirty();
+    uint32 moves = iThreatContainer.update();
+    if (ThreatUpdateCounters* counters = getUpdateCounters())
+    {
+        if (sorted)
+        {
+            ++counters->listSorts;
+            counters->listMoves += moves;
+        }
+        ++counters->victimSelections;
+    }
+
     HostileReference* nextVictim = iThreatContainer.selectNextVictim((Creature*) getOwner(), getCurrentVictim());
     setCurrentVictim(nextVictim);
     return getCurrentVictim() != nullptr ? getCurrentVictim()->getTarget() : nullptr;
@@ -564,6 +581,8 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
     switch (threatRefStatusChangeEvent->getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
+            if (ThreatUpdateCounters* counters = getUpdateCounters())
+                ++counters->threatChanges;
             if ((getCurrentVictim() == hostileReference && threatRefStatusChangeEvent->getFValue() < 0.0f) ||
                     (getCurrentVictim() != hostileReference && threatRefStatusChangeEvent->getFValue() > 0.0f))
                 setDirty(true);                             // the order in the threat list might have changed
@@ -608,6 +627,11 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
     }
 }
 
+ThreatUpdateCounters* ThreatManager::getUpdateCounters() const
+{
+    return iOwner->IsInWorld() ? &iOwner->GetMap()->GetThreatUpdateCounters() : nullptr;
+}
+
 void ThreatManager::UpdateForClient(uint32 diff)
 {
     if (!iUpdateNeed || isThreatListEmpty())
@@ -25,7 +25,9 @@
 #include "Entities/UnitEvents.h"
 #include "Timer.h"
 #include "Entities/ObjectGuid.h"
-#include <list>
+#include "Utilities/SlotList.h"
+
+#include <atomic>
 
 //==============================================================
 
@@ -36,6 +38,28 @@ struct SpellEntry;
 
 #define THREAT_UPDATE_INTERVAL (1 * IN_MILLISECONDS)        // Server should send threat update to client periodically each second
 
+//==============================================================
+// Threat work done during one map update, logged with long map updates.
+// Atomic since cells of a map can be updated in parallel.
+
+struct ThreatUpdateCounters
+{
+    ThreatUpdateCounters() { Reset(); }
+
+    void Reset()
+    {
+        threatChanges = 0;
+        listSorts = 0;
+        listMoves = 0;
+        victimSelections = 0;
+    }
+
+    std::atomic<uint32> threatChanges;                      // threat values changed
+    std::atomic<uint32> listSorts;                          // threat lists brought back in order
+    std::atomic<uint32> listMoves;                          // positions references were moved by these
+    std::atomic<uint32> victimSelections;                   // victims selected from a threat list
+};
+
 //==============================================================
 // Class to calculate the real threat based
 
@@ -134,7 +158,8 @@ class HostileReference : public Reference<Unit, ThreatManager>
 //==============================================================
 class ThreatManager;
 
-typedef std::list<HostileReference*> ThreatList;
+// sorted by threat, highest first, after ThreatContainer::update()
+typedef SlotList<HostileReference*> ThreatList;
 
 class ThreatContainer
 {
@@ -147,8 +172,8 @@ class ThreatContainer
         void remove(HostileReference* pRef) { iThreatList.remove(pRef); }
         void addReference(HostileReference* pHostileReference) { iThreatList.push_back(pHostileReference); }
         void clearReferences();
-        // Sort the list if necessary
-        void update();
+        // Sort the list if necessary, returns the positions references were moved by
+        uint32 update();
     public:
         ThreatContainer() { iDirty = false; }
         ~ThreatContainer() { clearReferences(); }
@@ -214,6 +239,8 @@ class ThreatManager
 
         void setDirty(bool pDirty) { iThreatContainer.setDirty(pDirty); }
 
+        ThreatUpdateCounters* getUpdateCounters() const;
+
         // Don't must be used for explicit modify threat values in iterator return pointers
         ThreatList const& getThreatList() const { return iThreatContainer.getThreatList(); }
     private:
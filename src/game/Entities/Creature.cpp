@@ -45,6 +45,7 @@
 #include "Grids/GridNotifiersImpl.h"
 #include "Grids/CellImpl.h"
 #include "Movement/MoveSplineInit.h"
+#include "Movement/MoveSpline.h"
 #include "Entities/CreatureLinkingMgr.h"
 
 // apply implementation of the singletons
@@ -137,6 +138,7 @@ Creature::Creature(CreatureSubtype subtype) : Unit(),
     m_AlreadyCallAssistance(false), m_AlreadySearchedAssistance(false),
     m_isDeadByDefault(false), m_temporaryFactionFlags(TEMPFACTION_NONE),
     m_meleeDamageSchoolMask(SPELL_SCHOOL_MASK_NORMAL), m_originalEntry(0),
+    m_localAurasVersion(0), m_localAuras(false),
     m_creatureInfo(nullptr), m_ai(nullptr)
 {
     m_regenTimer = 200;
@@ -618,6 +620,56 @@ void Creature::Update(uint32 update_diff, uint32 diff)
     }
 }
 
+bool Creature::IsLocalUpdate(uint32 diff)
+{
+    // respawn, corpse removal and linking act on the map and on other creatures
+    if (!isAlive() || m_isDeadByDefault || m_isCreatureLinkingTrigger || m_isSpawningLinked)
+        return false;
+
+    // combat, casts and events reach other units
+    if (isInCombat() || getVictim() || !getAttackers().empty() || GetFixateTargetGuid() || !m_Events.Empty())
+        return false;
+
+    if (!getThreatManager().isThreatListEmpty() || !getHostileRefManager().isEmpty())
+        return false;
+
+    for (uint32 i = 0; i < CURRENT_MAX_SPELL; ++i)
+        if (GetCurrentSpell(CurrentSpellTypes(i)))
+            return false;
+
+    // controlled creatures and transports move others along
+    if (GetOwnerGuid() || GetCharmerGuid() || IsVehicle() || IsBoarded() || !m_gameObj.empty())
+        return false;
+
+    // movement relocates in the grid and uses the shared path finding, so no relocation happens on worker threads
+    if (GetMotionMaster()->GetCurrentMovementGeneratorType() != IDLE_MOTION_TYPE || !movespline->Finalized())
+        return false;
+
+    // expiring or ticking auras trigger spells and scripts, only rechecked when the holders changed
+    if (m_localAurasVersion != GetSpellAuraHoldersVersion())
+    {
+        m_localAurasVersion = GetSpellAuraHoldersVersion();
+        m_localAuras = true;
+
+        SpellAuraHolderMap const& holders = GetSpellAuraHolderMap();
+        for (SpellAuraHolderMap::const_iterator itr = holders.begin(); itr != holders.end() && m_localAuras; ++itr)
+        {
+            if (!itr->second->IsPermanent() && !itr->second->IsPassive())
+                m_localAuras = false;
+
+            for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
+                if (Aura* aura = itr->second->GetAuraByEffectIndex(SpellEffectIndex(i)))
+                    if (aura->IsPeriodic())
+                        m_localAuras = false;
+        }
+    }
+
+    if (!m_localAuras)
+        return false;
+
+    return !AI() || AI()->IsLocalUpdate(diff);
+}
+
 void Creature::RegenerateAll(uint32 update_diff)
 {
     if (m_regenTimer > 0)
@@ -2213,7 +2265,7 @@ Unit* Creature::SelectAttackingTarget(AttackingTarget target, uint32 position, S
             suitableUnits.reserve(threatlist.size() - position);
 
             if (position)
-                advance(itr, position);
+                std::advance(itr, position);
 
             for (; itr != threatlist.end(); ++itr)
             {
@@ -2232,7 +2284,7 @@ Unit* Creature::SelectAttackingTarget(AttackingTarget target, uint32 position, S
         case ATTACKING_TARGET_TOPAGGRO:
         {
             if (position)
-                advance(itr, position);
+                std::advance(itr, position);
 
             for (; itr != threatlist.end(); ++itr)
             {
@@ -2250,7 +2302,7 @@ Unit* Creature::SelectAttackingTarget(AttackingTarget target, uint32 position, S
             ThreatList::const_reverse_iterator ritr = threatlist.rbegin();
 
             if (position)
-                advance(ritr, position);
+                std::advance(ritr, position);
 
             for (; ritr != threatlist.rend(); ++ritr)
             {
@@ -555,6 +555,7 @@ class Creature : public Unit
         char const* GetSubName() const { return GetCreatureInfo()->SubName; }
 
         void Update(uint32 update_diff, uint32 time) override;  // overwrite Unit::Update
+        bool IsLocalUpdate(uint32 diff);                    // the next update can't touch other objects, see Map::UpdateCellsInParallel
 
         virtual void RegenerateAll(uint32 update_diff);
         uint32 GetEquipmentId() const { return m_equipmentId; }
@@ -830,6 +831,9 @@ class Creature : public Unit
         SpellSchoolMask m_meleeDamageSchoolMask;
         uint32 m_originalEntry;
 
+        uint32 m_localAurasVersion;                         // holders version m_localAuras was checked at
+        bool m_localAuras;                                  // no holder expires or ticks
+
         float m_combatStartX;
         float m_combatStartY;
         float m_combatStartZ;
@@ -1152,12 +1152,10 @@ void Item::RemoveFromClientUpdateList()
         pl->GetMap()->RemoveUpdateObject(this);
 }
 
-void Item::BuildUpdateData(UpdateDataMapType& update_players)
+void Item::GetUpdateReceivers(UpdateReceiverList& receivers) const
 {
     if (Player* pl = GetOwner())
-        BuildUpdateDataForPlayer(pl, update_players);
-
-    ClearUpdateMask(false);
+        receivers.push_back(pl);
 }
 
 InventoryResult Item::CanBeMergedPartlyWith(ItemPrototype const* proto) const
@@ -378,7 +378,7 @@ class Item : public Object
 
         void AddToClientUpdateList() override;
         void RemoveFromClientUpdateList() override;
-        void BuildUpdateData(UpdateDataMapType& update_players) override;
+        void GetUpdateReceivers(UpdateReceiverList& receivers) const override;
     private:
         std::string m_text;
         uint8 m_slot;
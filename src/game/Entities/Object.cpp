@@ -48,6 +48,7 @@ Object::Object(): m_updateFlag(0)
 
     m_uint32Values      = nullptr;
     m_valuesCount       = 0;
+    m_changedValuesCount = 0;
 
     m_inWorld           = false;
     m_objectUpdated     = false;
@@ -79,7 +80,8 @@ void Object::_InitValues()
     m_uint32Values = new uint32[ m_valuesCount ];
     memset(m_uint32Values, 0, m_valuesCount * sizeof(uint32));
 
-    m_changedValues.resize(m_valuesCount, false);
+    m_changedValues.SetCount(m_valuesCount);
+    m_changedValuesCount = 0;
 
     m_objectUpdated = false;
 }
@@ -393,309 +395,316 @@ void Object::BuildMovementUpdate(ByteBuffer* data, uint16 updateFlags) const
     }
 }
 
-void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const
+void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target, SharedValuesUpdateBlock::TargetFieldList* targetFields /*= nullptr*/) const
 {
-    if (!target)
+    // without target only for shared blocks, target dependent values are written later
+    if (!target && !targetFields)
         return;
 
-    bool IsActivateToQuest = false;
-    bool IsPerCasterAuraState = false;
+    if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsDynTransport())
+    {
+        updateMask->SetBit(GAMEOBJECT_DYNAMIC);
+        if (updatetype == UPDATETYPE_VALUES)
+            updateMask->SetBit(GAMEOBJECT_BYTES_1);         // why do we need this here?
+    }
+    else if (isType(TYPEMASK_UNIT))
+    {
+        if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE))
+            updateMask->SetBit(UNIT_FIELD_AURASTATE);
+    }
+
+    MANGOS_ASSERT(updateMask && updateMask->GetCount() == m_valuesCount);
+
+    *data << (uint8)updateMask->GetBlockCount();
+    for (uint32 block = 0; block < updateMask->GetBlockCount(); ++block)
+        *data << updateMask->GetBlock(block);
 
-    if (updatetype == UPDATETYPE_CREATE_OBJECT || updatetype == UPDATETYPE_CREATE_OBJECT2)
+    // 2 specialized loops for speed optimization in non-unit case
+    if (isType(TYPEMASK_UNIT))                              // unit (creature/player) case
     {
-        if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsDynTransport())
+        for (uint32 index = updateMask->GetNextSetBit(0); index < m_valuesCount; index = updateMask->GetNextSetBit(index + 1))
         {
-            if (((GameObject*)this)->ActivateToQuest(target) || target->isGameMaster())
-                IsActivateToQuest = true;
+            if (index == UNIT_NPC_FLAGS || index == UNIT_FIELD_AURASTATE || index == UNIT_FIELD_FLAGS || index == UNIT_DYNAMIC_FLAGS)
+            {
+                if (targetFields)
+                {
+                    targetFields->push_back(SharedValuesUpdateBlock::TargetField(index, data->wpos()));
+                    *data << uint32(0);
+                }
+                else
+                    *data << GetTargetDependentValue(index, target);
+            }
+            // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
+            else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+            {
+                // convert from float to uint32 and send
+                *data << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+            }
 
-            updateMask->SetBit(GAMEOBJECT_DYNAMIC);
+            // there are some float values which may be negative or can't get negative due to other checks
+            else if ((index >= UNIT_FIELD_NEGSTAT0 && index <= UNIT_FIELD_NEGSTAT4) ||
+                     (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
+                     (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
+                     (index >= UNIT_FIELD_POSSTAT0 && index <= UNIT_FIELD_POSSTAT4))
+            {
+                *data << uint32(m_floatValues[index]);
+            }
+            else                                            // Unhandled index, just send
+            {
+                // send in current format (float as float, uint32 as uint32)
+                *data << m_uint32Values[index];
+            }
         }
-        else if (isType(TYPEMASK_UNIT))
+    }
+    else if (isType(TYPEMASK_GAMEOBJECT))                   // gameobject case
+    {
+        for (uint32 index = updateMask->GetNextSetBit(0); index < m_valuesCount; index = updateMask->GetNextSetBit(index + 1))
         {
-            if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE))
+            // send in current format (float as float, uint32 as uint32)
+            if (index == GAMEOBJECT_DYNAMIC)
             {
-                IsPerCasterAuraState = true;
-                updateMask->SetBit(UNIT_FIELD_AURASTATE);
+                if (targetFields)
+                {
+                    targetFields->push_back(SharedValuesUpdateBlock::TargetField(index, data->wpos()));
+                    *data << uint32(0);
+                }
+                else
+                    *data << GetTargetDependentValue(index, target);
             }
+            else
+                *data << m_uint32Values[index];             // other cases
         }
     }
-    else                                                    // case UPDATETYPE_VALUES
+    else                                                    // other objects case (no special index checks)
     {
-        if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsDynTransport())
+        for (uint32 index = updateMask->GetNextSetBit(0); index < m_valuesCount; index = updateMask->GetNextSetBit(index + 1))
         {
-            if (((GameObject*)this)->ActivateToQuest(target) || target->isGameMaster())
-                IsActivateToQuest = true;
-
-            updateMask->SetBit(GAMEOBJECT_DYNAMIC);
-            updateMask->SetBit(GAMEOBJECT_BYTES_1);         // why do we need this here?
+            // send in current format (float as float, uint32 as uint32)
+            *data << m_uint32Values[index];
         }
-        else if (isType(TYPEMASK_UNIT))
+    }
+}
+
+uint32 Object::GetTargetDependentValue(uint16 index, Player* target) const
+{
+    if (isType(TYPEMASK_GAMEOBJECT))
+    {
+        // GAMEOBJECT_DYNAMIC, sent as two uint16 values
+        // GAMEOBJECT_TYPE_DUNGEON_DIFFICULTY can have lo flag = 2
+        //      most likely related to "can enter map" and then should be 0 if can not enter
+        GameObject const* gameObject = static_cast<GameObject const*>(this);
+        uint16 dynFlags = 0;
+
+        if (!gameObject->IsDynTransport() && (gameObject->ActivateToQuest(target) || target->isGameMaster()))
         {
-            if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE))
+            switch (gameObject->GetGoType())
             {
-                IsPerCasterAuraState = true;
-                updateMask->SetBit(UNIT_FIELD_AURASTATE);
+                case GAMEOBJECT_TYPE_QUESTGIVER:
+                    // GO also seen with GO_DYNFLAG_LO_SPARKLE explicit, relation/reason unclear (192861)
+                    dynFlags = GO_DYNFLAG_LO_ACTIVATE;
+                    break;
+                case GAMEOBJECT_TYPE_CHEST:
+                    if (gameObject->getLootState() == GO_READY || gameObject->getLootState() == GO_ACTIVATED)
+                        dynFlags = GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
+                    break;
+                case GAMEOBJECT_TYPE_GENERIC:
+                case GAMEOBJECT_TYPE_SPELL_FOCUS:
+                case GAMEOBJECT_TYPE_GOOBER:
+                    dynFlags = GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
+                    break;
+                default:
+                    // unknown, not happen.
+                    break;
             }
         }
-    }
-
-    MANGOS_ASSERT(updateMask && updateMask->GetCount() == m_valuesCount);
+        // else disable quest object
 
-    *data << (uint8)updateMask->GetBlockCount();
-    data->append(updateMask->GetMask(), updateMask->GetLength());
+        return uint32(dynFlags) | (uint32(uint16(-1)) << 16);
+    }
 
-    // 2 specialized loops for speed optimization in non-unit case
-    if (isType(TYPEMASK_UNIT))                              // unit (creature/player) case
+    switch (index)
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        case UNIT_NPC_FLAGS:
         {
-            if (updateMask->GetBit(index))
-            {
-                if (index == UNIT_NPC_FLAGS)
-                {
-                    uint32 appendValue = m_uint32Values[index];
+            uint32 appendValue = m_uint32Values[index];
 
-                    if (GetTypeId() == TYPEID_UNIT)
-                    {
-                        if (!target->canSeeSpellClickOn((Creature*)this))
-                            appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
-
-                        if (appendValue & UNIT_NPC_FLAG_TRAINER)
-                        {
-                            if (!((Creature*)this)->IsTrainerOf(target, false))
-                                appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
-                        }
-
-                        if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
-                        {
-                            if (target->getClass() != CLASS_HUNTER)
-                                appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
-                        }
-                        
-                        if (appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
-                        {
-                            QuestRelationsMapBounds bounds = sObjectMgr.GetCreatureQuestRelationsMapBounds(((Creature*)this)->GetEntry());
-                            for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
-                            {
-                                Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
-                                if (target->CanSeeStartQuest(pQuest))
-                                {
-                                    appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
-                                    break;
-                                }
-                            }
-
-                            bounds = sObjectMgr.GetCreatureQuestInvolvedRelationsMapBounds(((Creature*)this)->GetEntry());
-                            for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
-                            {
-                                Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
-                                if (target->CanRewardQuest(pQuest, false))
-                                {
-                                    appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
-                                    break;
-                                }
-                            }
-                        }
-                    }
+            if (GetTypeId() == TYPEID_UNIT)
+            {
+                if (!target->canSeeSpellClickOn((Creature*)this))
+                    appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
 
-                    *data << uint32(appendValue);
-                }
-                else if (index == UNIT_FIELD_AURASTATE)
+                if (appendValue & UNIT_NPC_FLAG_TRAINER)
                 {
-                    if (IsPerCasterAuraState)
-                    {
-                        // IsPerCasterAuraState set if related pet caster aura state set already
-                        if (((Unit*)this)->HasAuraStateForCaster(AURA_STATE_CONFLAGRATE, target->GetObjectGuid()))
-                            *data << m_uint32Values[index];
-                        else
-                            *data << (m_uint32Values[index] & ~(1 << (AURA_STATE_CONFLAGRATE - 1)));
-                    }
-                    else
-                        *data << m_uint32Values[index];
-                }
-                // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
-                else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
-                {
-                    // convert from float to uint32 and send
-                    *data << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+                    if (!((Creature*)this)->IsTrainerOf(target, false))
+                        appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
                 }
 
-                // there are some float values which may be negative or can't get negative due to other checks
-                else if ((index >= UNIT_FIELD_NEGSTAT0 && index <= UNIT_FIELD_NEGSTAT4) ||
-                         (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
-                         (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
-                         (index >= UNIT_FIELD_POSSTAT0 && index <= UNIT_FIELD_POSSTAT4))
+                if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
                 {
-                    *data << uint32(m_floatValues[index]);
+                    if (target->getClass() != CLASS_HUNTER)
+                        appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
                 }
 
-                // Gamemasters should be always able to select units - remove not selectable flag
-                else if (index == UNIT_FIELD_FLAGS && target->isGameMaster())
+                if (appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
                 {
-                    *data << (m_uint32Values[index] & ~UNIT_FLAG_NOT_SELECTABLE);
-                }
-                // Hide special-info for non empathy-casters,
-                // Hide lootable animation for unallowed players
-                // Handle tapped flag
-                else if (index == UNIT_DYNAMIC_FLAGS)
-                {
-                    Creature* creature = (Creature*)this;
-                    uint32 dynflagsValue = m_uint32Values[index];
-                    bool setTapFlags = false;
-
-                    if (creature->isAlive())
+                    QuestRelationsMapBounds bounds = sObjectMgr.GetCreatureQuestRelationsMapBounds(((Creature*)this)->GetEntry());
+                    for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
                     {
-                        // Checking SPELL_AURA_EMPATHY and caster
-                        if (dynflagsValue & UNIT_DYNFLAG_SPECIALINFO)
-                        {
-                            bool bIsEmpathy = false;
-                            bool bIsCaster = false;
-                            Unit::AuraList const& mAuraEmpathy = creature->GetAurasByType(SPELL_AURA_EMPATHY);
-                            for (Unit::AuraList::const_iterator itr = mAuraEmpathy.begin(); !bIsCaster && itr != mAuraEmpathy.end(); ++itr)
-                            {
-                                bIsEmpathy = true;              // Empathy by aura set
-                                if ((*itr)->GetCasterGuid() == target->GetObjectGuid())
-                                    bIsCaster = true;           // target is the caster of an empathy aura
-                            }
-                            if (bIsEmpathy && !bIsCaster)       // Empathy by aura, but target is not the caster
-                                dynflagsValue &= ~UNIT_DYNFLAG_SPECIALINFO;
-                        }
-
-                        // creature is alive so, not lootable
-                        dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
-                        if (creature->isInCombat())
+                        Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
+                        if (target->CanSeeStartQuest(pQuest))
                         {
-                            // as creature is in combat we have to manage tap flags
-                            setTapFlags = true;
-                        }
-                        else
-                        {
-                            // creature is not in combat so its not tapped
-                            dynflagsValue = dynflagsValue & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
-                            //sLog.outString(">> %s is not in combat so not tapped by %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
+                            appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
+                            break;
                         }
                     }
-                    else
+
+                    bounds = sObjectMgr.GetCreatureQuestInvolvedRelationsMapBounds(((Creature*)this)->GetEntry());
+                    for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
                     {
-                        // check loot flag
-                        if (creature->loot && creature->loot->CanLoot(target))
-                        {
-                            // creature is dead and this player can loot it
-                            dynflagsValue = dynflagsValue | UNIT_DYNFLAG_LOOTABLE;
-                            //sLog.outString(">> %s is lootable for %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
-                        }
-                        else
+                        Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
+                        if (target->CanRewardQuest(pQuest, false))
                         {
-                            // creature is dead but this player cannot loot it
-                            dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
-                            //sLog.outString(">> %s is not lootable for %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
+                            appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
+                            break;
                         }
-
-                        // as creature is died we have to manage tap flags
-                        setTapFlags = true;
                     }
+                }
+            }
+
+            return appendValue;
+        }
+        case UNIT_FIELD_AURASTATE:
+        {
+            // per caster aura state only visible for the caster of the related aura
+            if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE) && !((Unit*)this)->HasAuraStateForCaster(AURA_STATE_CONFLAGRATE, target->GetObjectGuid()))
+                return m_uint32Values[index] & ~(1 << (AURA_STATE_CONFLAGRATE - 1));
+
+            return m_uint32Values[index];
+        }
+        case UNIT_FIELD_FLAGS:
+        {
+            // Gamemasters should be always able to select units - remove not selectable flag
+            if (target->isGameMaster())
+                return m_uint32Values[index] & ~UNIT_FLAG_NOT_SELECTABLE;
 
-                    // check tap flags
-                    if (setTapFlags)
+            return m_uint32Values[index];
+        }
+        case UNIT_DYNAMIC_FLAGS:
+        {
+            // Hide special-info for non empathy-casters,
+            // Hide lootable animation for unallowed players
+            // Handle tapped flag
+            Creature* creature = (Creature*)this;
+            uint32 dynflagsValue = m_uint32Values[index];
+            bool setTapFlags = false;
+
+            if (creature->isAlive())
+            {
+                // Checking SPELL_AURA_EMPATHY and caster
+                if (dynflagsValue & UNIT_DYNFLAG_SPECIALINFO)
+                {
+                    bool bIsEmpathy = false;
+                    bool bIsCaster = false;
+                    Unit::AuraList const& mAuraEmpathy = creature->GetAurasByType(SPELL_AURA_EMPATHY);
+                    for (Unit::AuraList::const_iterator itr = mAuraEmpathy.begin(); !bIsCaster && itr != mAuraEmpathy.end(); ++itr)
                     {
-                        dynflagsValue = dynflagsValue | UNIT_DYNFLAG_TAPPED;
-                        if (creature->IsTappedBy(target))
-                        {
-                            // creature is in combat or died and tapped by this player
-                            dynflagsValue = dynflagsValue | UNIT_DYNFLAG_TAPPED_BY_PLAYER;
-                            //sLog.outString(">> %s is tapped by %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
-                        }
-                        else
-                        {
-                            // creature is in combat or died but not tapped by this player
-                            dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED_BY_PLAYER;
-                            //sLog.outString(">> %s is not tapped by %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
-                        }
+                        bIsEmpathy = true;              // Empathy by aura set
+                        if ((*itr)->GetCasterGuid() == target->GetObjectGuid())
+                            bIsCaster = true;           // target is the caster of an empathy aura
                     }
+                    if (bIsEmpathy && !bIsCaster)       // Empathy by aura, but target is not the caster
+                        dynflagsValue &= ~UNIT_DYNFLAG_SPECIALINFO;
+                }
 
-                    *data << dynflagsValue;
+                // creature is alive so, not lootable
+                dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
+                if (creature->isInCombat())
+                {
+                    // as creature is in combat we have to manage tap flags
+                    setTapFlags = true;
                 }
-                else                                        // Unhandled index, just send
+                else
                 {
-                    // send in current format (float as float, uint32 as uint32)
-                    *data << m_uint32Values[index];
+                    // creature is not in combat so its not tapped
+                    dynflagsValue = dynflagsValue & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
+                    //sLog.outString(">> %s is not in combat so not tapped by %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
                 }
             }
-        }
-    }
-    else if (isType(TYPEMASK_GAMEOBJECT))                   // gameobject case
-    {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
-        {
-            if (updateMask->GetBit(index))
+            else
             {
-                // send in current format (float as float, uint32 as uint32)
-                if (index == GAMEOBJECT_DYNAMIC)
+                // check loot flag
+                if (creature->loot && creature->loot->CanLoot(target))
                 {
-                    // GAMEOBJECT_TYPE_DUNGEON_DIFFICULTY can have lo flag = 2
-                    //      most likely related to "can enter map" and then should be 0 if can not enter
-
-                    if (IsActivateToQuest)
-                    {
-                        GameObject const* gameObject = static_cast<GameObject const*>(this);
-                        switch (((GameObject*)this)->GetGoType())
-                        {
-                            case GAMEOBJECT_TYPE_QUESTGIVER:
-                                // GO also seen with GO_DYNFLAG_LO_SPARKLE explicit, relation/reason unclear (192861)
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
-                                *data << uint16(-1);
-                                break;
-                            case GAMEOBJECT_TYPE_CHEST:
-                                if (gameObject->getLootState() == GO_READY || gameObject->getLootState() == GO_ACTIVATED)
-                                    *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
-                                else
-                                    *data << uint16(0);
-                                *data << uint16(-1);
-                                break;
-                            case GAMEOBJECT_TYPE_GENERIC:
-                            case GAMEOBJECT_TYPE_SPELL_FOCUS:
-                            case GAMEOBJECT_TYPE_GOOBER:
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
-                                *data << uint16(-1);
-                                break;
-                            default:
-                                // unknown, not happen.
-                                *data << uint16(0);
-                                *data << uint16(-1);
-                                break;
-                        }
-                    }
-                    else
-                    {
-                        // disable quest object
-                        *data << uint16(0);
-                        *data << uint16(-1);
-                    }
+                    // creature is dead and this player can loot it
+                    dynflagsValue = dynflagsValue | UNIT_DYNFLAG_LOOTABLE;
+                    //sLog.outString(">> %s is lootable for %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
                 }
                 else
-                    *data << m_uint32Values[index];         // other cases
+                {
+                    // creature is dead but this player cannot loot it
+                    dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
+                    //sLog.outString(">> %s is not lootable for %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
+                }
+
+                // as creature is died we have to manage tap flags
+                setTapFlags = true;
             }
-        }
-    }
-    else                                                    // other objects case (no special index checks)
-    {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
-        {
-            if (updateMask->GetBit(index))
+
+            // check tap flags
+            if (setTapFlags)
             {
-                // send in current format (float as float, uint32 as uint32)
-                *data << m_uint32Values[index];
+                dynflagsValue = dynflagsValue | UNIT_DYNFLAG_TAPPED;
+                if (creature->IsTappedBy(target))
+                {
+                    // creature is in combat or died and tapped by this player
+                    dynflagsValue = dynflagsValue | UNIT_DYNFLAG_TAPPED_BY_PLAYER;
+                    //sLog.outString(">> %s is tapped by %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
+                }
+                else
+                {
+                    // creature is in combat or died but not tapped by this player
+                    dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED_BY_PLAYER;
+                    //sLog.outString(">> %s is not tapped by %s", this->GetObjectGuid().GetString().c_str(), target->GetObjectGuid().GetString().c_str());
+                }
             }
+
+            return dynflagsValue;
         }
+        default:
+            return m_uint32Values[index];
     }
 }
 
+void Object::BuildSharedValuesUpdateBlock(SharedValuesUpdateBlock& block) const
+{
+    block.data << uint8(UPDATETYPE_VALUES);
+    block.data << GetPackGUID();
+
+    UpdateMask updateMask;
+    updateMask.SetCount(m_valuesCount);
+
+    // the change mask only differs for the object itself
+    _SetUpdateBits(&updateMask, nullptr);
+    BuildValuesUpdate(UPDATETYPE_VALUES, &block.data, &updateMask, nullptr, &block.targetFields);
+}
+
+void Object::AddSharedValuesUpdateBlock(UpdateData* data, SharedValuesUpdateBlock const& block, Player* target) const
+{
+    ByteBuffer buf(block.data.size());
+    buf.append(block.data);
+
+    for (SharedValuesUpdateBlock::TargetFieldList::const_iterator itr = block.targetFields.begin(); itr != block.targetFields.end(); ++itr)
+        buf.put<uint32>(itr->second, GetTargetDependentValue(itr->first, target));
+
+    data->AddUpdateBlock(buf);
+}
+
 void Object::ClearUpdateMask(bool remove)
 {
-    if (m_uint32Values)
+    if (m_changedValuesCount)
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
-            m_changedValues[index] = false;
+        m_changedValues.Clear();
+        m_changedValuesCount = 0;
     }
 
     if (m_objectUpdated)
@@ -727,9 +736,7 @@ bool Object::LoadValues(const char* data)
 
 void Object::_SetUpdateBits(UpdateMask* updateMask, Player* /*target*/) const
 {
-    for (uint16 index = 0; index < m_valuesCount; ++index)
-        if (m_changedValues[index])
-            updateMask->SetBit(index);
+    *updateMask |= m_changedValues;
 }
 
 void Object::_SetCreateBits(UpdateMask* updateMask, Player* /*target*/) const
@@ -746,7 +753,7 @@ void Object::SetInt32Value(uint16 index, int32 value)
     if (m_int32Values[index] != value)
     {
         m_int32Values[index] = value;
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -758,7 +765,7 @@ void Object::SetUInt32Value(uint16 index, uint32 value)
     if (m_uint32Values[index] != value)
     {
         m_uint32Values[index] = value;
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -770,8 +777,8 @@ void Object::SetUInt64Value(uint16 index, const uint64& value)
     {
         m_uint32Values[index] = *((uint32*)&value);
         m_uint32Values[index + 1] = *(((uint32*)&value) + 1);
-        m_changedValues[index] = true;
-        m_changedValues[index + 1] = true;
+        MarkChangedValue(index);
+        MarkChangedValue(index + 1);
         MarkForClientUpdate();
     }
 }
@@ -783,7 +790,7 @@ void Object::SetFloatValue(uint16 index, float value)
     if (m_floatValues[index] != value)
     {
         m_floatValues[index] = value;
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -802,7 +809,7 @@ void Object::SetByteValue(uint16 index, uint8 offset, uint8 value)
     {
         m_uint32Values[index] &= ~uint32(uint32(0xFF) << (offset * 8));
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 8));
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -821,7 +828,7 @@ void Object::SetUInt16Value(uint16 index, uint8 offset, uint16 value)
     {
         m_uint32Values[index] &= ~uint32(uint32(0xFFFF) << (offset * 16));
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 16));
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -883,7 +890,7 @@ void Object::SetFlag(uint16 index, uint32 newFlag)
     if (oldval != newval)
     {
         m_uint32Values[index] = newval;
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -897,7 +904,7 @@ void Object::RemoveFlag(uint16 index, uint32 oldFlag)
     if (oldval != newval)
     {
         m_uint32Values[index] = newval;
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -915,7 +922,7 @@ void Object::SetByteFlag(uint16 index, uint8 offset, uint8 newFlag)
     if (!(uint8(m_uint32Values[index] >> (offset * 8)) & newFlag))
     {
         m_uint32Values[index] |= uint32(uint32(newFlag) << (offset * 8));
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -933,7 +940,7 @@ void Object::RemoveByteFlag(uint16 index, uint8 offset, uint8 oldFlag)
     if (uint8(m_uint32Values[index] >> (offset * 8)) & oldFlag)
     {
         m_uint32Values[index] &= ~uint32(uint32(oldFlag) << (offset * 8));
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -945,7 +952,7 @@ void Object::SetShortFlag(uint16 index, bool highpart, uint16 newFlag)
     if (!(uint16(m_uint32Values[index] >> (highpart ? 16 : 0)) & newFlag))
     {
         m_uint32Values[index] |= uint32(uint32(newFlag) << (highpart ? 16 : 0));
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -957,7 +964,7 @@ void Object::RemoveShortFlag(uint16 index, bool highpart, uint16 oldFlag)
     if (uint16(m_uint32Values[index] >> (highpart ? 16 : 0)) & oldFlag)
     {
         m_uint32Values[index] &= ~uint32(uint32(oldFlag) << (highpart ? 16 : 0));
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -1004,12 +1011,23 @@ void Object::RemoveFromClientUpdateList()
     MANGOS_ASSERT(false);
 }
 
-void Object::BuildUpdateData(UpdateDataMapType& /*update_players */)
+void Object::GetUpdateReceivers(UpdateReceiverList& /*receivers*/) const
 {
-    sLog.outError("Unexpected call of Object::BuildUpdateData for object (TypeId: %u Update fields: %u)", GetTypeId(), m_valuesCount);
+    sLog.outError("Unexpected call of Object::GetUpdateReceivers for object (TypeId: %u Update fields: %u)", GetTypeId(), m_valuesCount);
     MANGOS_ASSERT(false);
 }
 
+void Object::BuildUpdateData(UpdateDataMapType& update_players)
+{
+    UpdateReceiverList receivers;
+    GetUpdateReceivers(receivers);
+
+    for (UpdateReceiverList::const_iterator itr = receivers.begin(); itr != receivers.end(); ++itr)
+        BuildUpdateDataForPlayer(*itr, update_players);
+
+    ClearUpdateMask(false);
+}
+
 void Object::MarkForClientUpdate()
 {
     if (m_inWorld)
@@ -1024,7 +1042,7 @@ void Object::MarkForClientUpdate()
 
 void Object::ForceValuesUpdateAtIndex(uint32 index)
 {
-    m_changedValues[index] = true;
+    MarkChangedValue(index);
     if (m_inWorld && !m_objectUpdated)
     {
         AddToClientUpdateList();
@@ -2003,14 +2021,14 @@ void WorldObject::RemoveFromClientUpdateList()
 
 struct WorldObjectChangeAccumulator
 {
-    UpdateDataMapType& i_updateDatas;
-    WorldObject& i_object;
-    WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataMapType& d) : i_updateDatas(d), i_object(obj)
+    UpdateReceiverList& i_receivers;
+    WorldObject const& i_object;
+    WorldObjectChangeAccumulator(WorldObject const& obj, UpdateReceiverList& receivers) : i_receivers(receivers), i_object(obj)
     {
         // send self fields changes in another way, otherwise
         // with new camera system when player's camera too far from player, camera wouldn't receive packets and changes from player
         if (i_object.isType(TYPEMASK_PLAYER))
-            i_object.BuildUpdateDataForPlayer((Player*)&i_object, i_updateDatas);
+            i_receivers.push_back((Player*)&i_object);
     }
 
     void Visit(CameraMapType& m)
@@ -2019,19 +2037,17 @@ struct WorldObjectChangeAccumulator
         {
             Player* owner = iter->getSource()->GetOwner();
             if (owner != &i_object && owner->HaveAtClient(&i_object))
-                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas);
+                i_receivers.push_back(owner);
         }
     }
 
     template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
 };
 
-void WorldObject::BuildUpdateData(UpdateDataMapType& update_players)
+void WorldObject::GetUpdateReceivers(UpdateReceiverList& receivers) const
 {
-    WorldObjectChangeAccumulator notifier(*this, update_players);
+    WorldObjectChangeAccumulator notifier(*this, receivers);
     Cell::VisitWorldObjects(this, notifier, GetMap()->GetVisibilityDistance());
-
-    ClearUpdateMask(false);
 }
 
 bool WorldObject::IsControlledByPlayer() const
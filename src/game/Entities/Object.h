@@ -23,6 +23,7 @@
 #include "ByteBuffer.h"
 #include "Entities/UpdateFields.h"
 #include "Entities/UpdateData.h"
+#include "Entities/UpdateMask.h"
 #include "Entities/ObjectGuid.h"
 #include "Camera.h"
 
@@ -77,7 +78,6 @@ class Player;
 class Unit;
 class Group;
 class Map;
-class UpdateMask;
 class InstanceData;
 class TerrainInfo;
 class TransportInfo;
@@ -85,6 +85,19 @@ struct MangosStringLocale;
 class Loot;
 
 typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
+typedef std::vector<Player*> UpdateReceiverList;
+
+// values update block of an object built once for all receivers except the object itself
+struct SharedValuesUpdateBlock
+{
+    typedef std::pair<uint16, size_t> TargetField;          // field index, position of its value in data
+    typedef std::vector<TargetField> TargetFieldList;
+
+    SharedValuesUpdateBlock() : data(0) {}
+
+    ByteBuffer data;
+    TargetFieldList targetFields;                           // values depending on the receiver, written per receiver
+};
 
 struct Position
 {
@@ -174,11 +187,15 @@ class Object
         // must be overwrite in appropriate subclasses (WorldObject, Item currently), or will crash
         virtual void AddToClientUpdateList();
         virtual void RemoveFromClientUpdateList();
-        virtual void BuildUpdateData(UpdateDataMapType& update_players);
+        virtual void GetUpdateReceivers(UpdateReceiverList& receivers) const;
+        void BuildUpdateData(UpdateDataMapType& update_players);
         void MarkForClientUpdate();
         void SendForcedObjectUpdate();
 
         void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const;
+        // same block as BuildValuesUpdateBlockForPlayer for any receiver but the object itself
+        void BuildSharedValuesUpdateBlock(SharedValuesUpdateBlock& block) const;
+        void AddSharedValuesUpdateBlock(UpdateData* data, SharedValuesUpdateBlock const& block, Player* target) const;
         void BuildOutOfRangeUpdateBlock(UpdateData* data) const;
         void BuildMovementUpdateBlock(UpdateData* data, uint16 flags = 0) const;
 
@@ -360,6 +377,7 @@ class Object
         }
 
         void ClearUpdateMask(bool remove);
+        bool HasChangedValues() const { return m_changedValuesCount != 0; }
 
         bool LoadValues(const char* data);
 
@@ -382,7 +400,9 @@ class Object
         virtual void _SetCreateBits(UpdateMask* updateMask, Player* target) const;
 
         void BuildMovementUpdate(ByteBuffer* data, uint16 updateFlags) const;
-        void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const;
+        void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target, SharedValuesUpdateBlock::TargetFieldList* targetFields = nullptr) const;
+        // value of a field which is sent differently to each receiver
+        uint32 GetTargetDependentValue(uint16 index, Player* target) const;
         void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players) const;
 
         uint16 m_objectType;
@@ -397,7 +417,14 @@ class Object
             float*  m_floatValues;
         };
 
-        std::vector<bool> m_changedValues;
+        void MarkChangedValue(uint16 index)
+        {
+            if (m_changedValues.TrySetBit(index))
+                ++m_changedValuesCount;
+        }
+
+        UpdateMask m_changedValues;                         // one bit per field changed since the last update
+        uint16 m_changedValuesCount;                        // set bits in m_changedValues
 
         uint16 m_valuesCount;
 
@@ -620,7 +647,7 @@ class WorldObject : public Object
 
         void AddToClientUpdateList() override;
         void RemoveFromClientUpdateList() override;
-        void BuildUpdateData(UpdateDataMapType&) override;
+        void GetUpdateReceivers(UpdateReceiverList& receivers) const override;
 
         Creature* SummonCreature(uint32 id, float x, float y, float z, float ang, TempSummonType spwtype, uint32 despwtime, bool asActiveObject = false, bool setRun = false, uint32 pathId = 0);
 
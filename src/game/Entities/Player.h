@@ -1008,6 +1008,107 @@ class TradeData
         ObjectGuid m_items[TRADE_SLOT_COUNT];               // traded itmes from m_player side including non-traded slot
 };
 
+/**
+ * Guids of the objects a player client knows, kept sorted in flat vectors.
+ *
+ * A visibility update stamps every object it finds with the current visit generation
+ * instead of copying the set and erasing what it finds. The entries still carrying an
+ * older stamp afterwards are out of range and are removed in a single sweep.
+ */
+class ClientGuidSet
+{
+    public:
+        typedef std::vector<ObjectGuid>::const_iterator const_iterator;
+
+        ClientGuidSet() : m_generation(1) {}
+
+        const_iterator begin() const { return m_guids.begin(); }
+        const_iterator end() const { return m_guids.end(); }
+        bool empty() const { return m_guids.empty(); }
+        size_t size() const { return m_guids.size(); }
+
+        bool contains(ObjectGuid const& guid) const { return std::binary_search(m_guids.begin(), m_guids.end(), guid); }
+
+        // new guids count as visited in a running visit
+        void insert(ObjectGuid const& guid)
+        {
+            std::vector<ObjectGuid>::iterator itr = std::lower_bound(m_guids.begin(), m_guids.end(), guid);
+            if (itr != m_guids.end() && *itr == guid)
+                return;
+
+            m_visitStamps.insert(m_visitStamps.begin() + (itr - m_guids.begin()), m_generation);
+            m_guids.insert(itr, guid);
+        }
+
+        void erase(ObjectGuid const& guid)
+        {
+            std::vector<ObjectGuid>::iterator itr = std::lower_bound(m_guids.begin(), m_guids.end(), guid);
+            if (itr == m_guids.end() || *itr != guid)
+                return;
+
+            m_visitStamps.erase(m_visitStamps.begin() + (itr - m_guids.begin()));
+            m_guids.erase(itr);
+        }
+
+        void clear()
+        {
+            m_guids.clear();
+            m_visitStamps.clear();
+        }
+
+        void BeginVisit()
+        {
+            // on wrap around old stamps could match again
+            if (++m_generation == 0)
+            {
+                std::fill(m_visitStamps.begin(), m_visitStamps.end(), 0);
+                m_generation = 1;
+            }
+        }
+
+        // true if the guid is known and was not visited yet in this visit
+        bool MarkVisited(ObjectGuid const& guid)
+        {
+            std::vector<ObjectGuid>::const_iterator itr = std::lower_bound(m_guids.begin(), m_guids.end(), guid);
+            if (itr == m_guids.end() || *itr != guid)
+                return false;
+
+            uint32& stamp = m_visitStamps[itr - m_guids.begin()];
+            if (stamp == m_generation)
+                return false;
+
+            stamp = m_generation;
+            return true;
+        }
+
+        // removes all guids not visited in this visit, calling func for each
+        template<typename F>
+        void EraseNotVisited(F func)
+        {
+            size_t kept = 0;
+            for (size_t i = 0; i < m_guids.size(); ++i)
+            {
+                if (m_visitStamps[i] != m_generation)
+                {
+                    func(m_guids[i]);
+                    continue;
+                }
+
+                m_guids[kept] = m_guids[i];
+                m_visitStamps[kept] = m_visitStamps[i];
+                ++kept;
+            }
+
+            m_guids.resize(kept);
+            m_visitStamps.resize(kept);
+        }
+
+    private:
+        std::vector<ObjectGuid> m_guids;
+        std::vector<uint32> m_visitStamps;                  // visit generation each guid was last found in, parallel to m_guids
+        uint32 m_generation;
+};
+
 class Player : public Unit
 {
         friend class WorldSession;
@@ -2238,9 +2339,9 @@ class Player : public Unit
         Object* GetObjectByTypeMask(ObjectGuid guid, TypeMask typemask);
 
         // currently visible objects at player client
-        GuidSet m_clientGUIDs;
+        ClientGuidSet m_clientGUIDs;
 
-        bool HaveAtClient(WorldObject const* u) { return u == this || m_clientGUIDs.find(u->GetObjectGuid()) != m_clientGUIDs.end(); }
+        bool HaveAtClient(WorldObject const* u) { return u == this || m_clientGUIDs.contains(u->GetObjectGuid()); }
 
         bool IsVisibleInGridForPlayer(Player* pl) const override;
         bool IsVisibleGloballyFor(Player* pl) const;
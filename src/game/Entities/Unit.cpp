@@ -275,6 +275,8 @@ Unit::Unit() :
     // m_AurasCheck = 2000;
     // m_removeAuraTimer = 4;
     m_spellAuraHoldersUpdateIterator = m_spellAuraHolders.end();
+    m_spellAuraHoldersVersion = 1;
+    m_procAuraHoldersVersion = sSpellMgr.GetSpellProcEventsVersion();
     m_AuraFlags = 0;
 
     m_Visibility = VISIBILITY_ON;
@@ -735,7 +737,7 @@ uint32 Unit::DealDamage(Unit* pVictim, uint32 damage, CleanDamage const* cleanDa
 
     // share damage by auras
     AuraList const& vShareDamageAuras = pVictim->GetAurasByType(SPELL_AURA_SHARE_DAMAGE_PCT);
-    for (AuraList::const_iterator itr = vShareDamageAuras.begin(); itr != vShareDamageAuras.end(); ++itr)
+    for (AuraList::Walker itr(vShareDamageAuras); !itr.AtEnd(); ++itr)
     {
         // if damage is done by another shared aura, then skip to avoid circular reference (aura 300 is only applied on effect_idx_0
         if (spellProto && spellProto->Effect[EFFECT_INDEX_0] == SPELL_EFFECT_APPLY_AURA &&
@@ -2031,7 +2033,7 @@ void Unit::CalculateDamageAbsorbAndResist(Unit* pCaster, SpellSchoolMask schoolM
 
     // absorb without mana cost
     AuraList const& vSchoolAbsorb = GetAurasByType(SPELL_AURA_SCHOOL_ABSORB);
-    for (AuraList::const_iterator i = vSchoolAbsorb.begin(); i != vSchoolAbsorb.end() && RemainingDamage > 0; ++i)
+    for (AuraList::Walker i(vSchoolAbsorb); !i.AtEnd() && RemainingDamage > 0; ++i)
     {
         Modifier* mod = (*i)->GetModifier();
         if (!(mod->m_miscvalue & schoolMask))
@@ -2360,10 +2362,8 @@ void Unit::CalculateDamageAbsorbAndResist(Unit* pCaster, SpellSchoolMask schoolM
     if (pCaster != this)
     {
         AuraList const& vSplitDamageFlat = GetAurasByType(SPELL_AURA_SPLIT_DAMAGE_FLAT);
-        for (AuraList::const_iterator i = vSplitDamageFlat.begin(), next; i != vSplitDamageFlat.end() && RemainingDamage >= 0; i = next)
+        for (AuraList::Walker i(vSplitDamageFlat); !i.AtEnd() && RemainingDamage >= 0; ++i)
         {
-            next = i; ++next;
-
             // check damage school mask
             if (((*i)->GetModifier()->m_miscvalue & schoolMask) == 0)
                 continue;
@@ -2397,10 +2397,8 @@ void Unit::CalculateDamageAbsorbAndResist(Unit* pCaster, SpellSchoolMask schoolM
         }
 
         AuraList const& vSplitDamagePct = GetAurasByType(SPELL_AURA_SPLIT_DAMAGE_PCT);
-        for (AuraList::const_iterator i = vSplitDamagePct.begin(), next; i != vSplitDamagePct.end() && RemainingDamage >= 0; i = next)
+        for (AuraList::Walker i(vSplitDamagePct); !i.AtEnd() && RemainingDamage >= 0; ++i)
         {
-            next = i; ++next;
-
             // check damage school mask
             if (((*i)->GetModifier()->m_miscvalue & schoolMask) == 0)
                 continue;
@@ -4955,6 +4953,8 @@ bool Unit::AddSpellAuraHolder(SpellAuraHolder* holder)
     // add aura, register in lists and arrays
     holder->_AddSpellAuraHolder();
     m_spellAuraHolders.insert(SpellAuraHolderMap::value_type(holder->GetId(), holder));
+    AddProcAuraHolder(holder);
+    ChangeSpellAuraHoldersVersion();
 
     for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
         if (Aura* aur = holder->GetAuraByEffectIndex(SpellEffectIndex(i)))
@@ -5622,6 +5622,8 @@ void Unit::RemoveSpellAuraHolder(SpellAuraHolder* holder, AuraRemoveMode mode)
         if (itr->second == holder)
         {
             m_spellAuraHolders.erase(itr);
+            RemoveProcAuraHolder(holder);
+            ChangeSpellAuraHoldersVersion();
             break;
         }
     }
@@ -9002,7 +9004,6 @@ void Unit::UpdateVisibilityAndView()
 
             if (!owner || !isVisibleForOrDetect(owner, this, false))
             {
-                alist.erase(it);
                 RemoveAura(aura);
                 it = alist.begin();
             }
@@ -10838,24 +10839,35 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* pTarget, uint32 procFlag,
 
     RemoveSpellList removedSpells;
     ProcTriggeredList procTriggered;
-    // Fill procTriggered list
-    for (SpellAuraHolderMap::const_iterator itr = GetSpellAuraHolderMap().begin(); itr != GetSpellAuraHolderMap().end(); ++itr)
+
+    // only process damage case on victim
+    bool damageTaken = isVictim && (procFlag & PROC_FLAG_TAKEN_ANY_DAMAGE) && !(procSpell && procSpell->HasAttribute(SPELL_ATTR_EX4_DAMAGE_DOESNT_BREAK_AURAS));
+
+    // proc flags of the index are stale after a reload of the spell proc events
+    if (m_procAuraHoldersVersion != sSpellMgr.GetSpellProcEventsVersion())
+        RebuildProcAuraHolders();
+
+    // Fill procTriggered list, holders without matching proc flags can not trigger
+    for (ProcAuraHolderList::const_iterator itr = m_procAuraHolders.begin(); itr != m_procAuraHolders.end(); ++itr)
     {
+        if (!(itr->procFlags & procFlag) && !(damageTaken && itr->interruptedByDamage))
+            continue;
+
+        SpellAuraHolder* holder = itr->holder;
+
         // skip deleted auras (possible at recursive triggered call
-        if (itr->second->GetState() != SPELLAURAHOLDER_STATE_READY || itr->second->IsDeleted())
+        if (holder->GetState() != SPELLAURAHOLDER_STATE_READY || holder->IsDeleted())
             continue;
 
         SpellProcEventEntry const* spellProcEvent = nullptr;
         // check if that aura is triggered by proc event (then it will be managed by proc handler)
-        if (!IsTriggeredAtSpellProcEvent(pTarget, itr->second, procSpell, procFlag, procExtra, attType, isVictim, spellProcEvent, dontTriggerSpecial))
+        if (!IsTriggeredAtSpellProcEvent(pTarget, holder, procSpell, procFlag, procExtra, attType, isVictim, spellProcEvent, dontTriggerSpecial))
         {
             // spell seem not managed by proc system, although some case need to be handled
-
-            // only process damage case on victim
-            if (!isVictim || !(procFlag & PROC_FLAG_TAKEN_ANY_DAMAGE) || (procSpell && procSpell->HasAttribute(SPELL_ATTR_EX4_DAMAGE_DOESNT_BREAK_AURAS)))
+            if (!damageTaken)
                 continue;
 
-            const SpellEntry* se = itr->second->GetSpellProto();
+            const SpellEntry* se = holder->GetSpellProto();
 
             // check if the aura is interruptible by damage and if its not just added by this spell (spell who is responsible for this damage is procSpell)
             if (se->AuraInterruptFlags & AURA_INTERRUPT_FLAG_DAMAGE && (!procSpell || procSpell->Id != se->Id))
@@ -10866,8 +10878,8 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* pTarget, uint32 procFlag,
             continue;
         }
 
-        itr->second->SetInUse(true);                        // prevent holder deletion
-        procTriggered.push_back(ProcTriggeredData(spellProcEvent, itr->second));
+        holder->SetInUse(true);                             // prevent holder deletion
+        procTriggered.push_back(ProcTriggeredData(spellProcEvent, holder));
     }
 
     if (!procTriggered.empty())
@@ -10961,6 +10973,47 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* pTarget, uint32 procFlag,
     }
 }
 
+void Unit::AddProcAuraHolder(SpellAuraHolder* holder)
+{
+    SpellEntry const* spellProto = holder->GetSpellProto();
+
+    // same flags as checked by IsTriggeredAtSpellProcEvent
+    uint32 procFlags = spellProto->procFlags;
+    SpellProcEventEntry const* spellProcEvent = sSpellMgr.GetSpellProcEvent(spellProto->Id);
+    if (spellProcEvent && spellProcEvent->procFlags)
+        procFlags = spellProcEvent->procFlags;
+
+    bool interruptedByDamage = (spellProto->AuraInterruptFlags & AURA_INTERRUPT_FLAG_DAMAGE) != 0;
+    if (!procFlags && !interruptedByDamage)
+        return;
+
+    // after holders of the same spell, as in the holder multimap
+    ProcAuraHolderList::iterator itr = std::upper_bound(m_procAuraHolders.begin(), m_procAuraHolders.end(), holder->GetId(),
+                                       [](uint32 spellId, ProcAuraHolder const& entry) { return spellId < entry.holder->GetId(); });
+    m_procAuraHolders.insert(itr, ProcAuraHolder(holder, procFlags, interruptedByDamage));
+}
+
+void Unit::RebuildProcAuraHolders()
+{
+    m_procAuraHolders.clear();
+    for (SpellAuraHolderMap::const_iterator itr = m_spellAuraHolders.begin(); itr != m_spellAuraHolders.end(); ++itr)
+        AddProcAuraHolder(itr->second);
+
+    m_procAuraHoldersVersion = sSpellMgr.GetSpellProcEventsVersion();
+}
+
+void Unit::RemoveProcAuraHolder(SpellAuraHolder* holder)
+{
+    for (ProcAuraHolderList::iterator itr = m_procAuraHolders.begin(); itr != m_procAuraHolders.end(); ++itr)
+    {
+        if (itr->holder == holder)
+        {
+            m_procAuraHolders.erase(itr);
+            break;
+        }
+    }
+}
+
 SpellSchoolMask Unit::GetMeleeDamageSchoolMask() const
 {
     return SPELL_SCHOOL_MASK_NORMAL;
@@ -11973,10 +12026,11 @@ bool Unit::IsAllowedDamageInArea(Unit* pVictim) const
     return true;
 }
 
-class RelocationNotifyEvent : public BasicEvent
+// scheduled on every relocation, its memory is reused instead of allocated each time
+class RelocationNotifyEvent : public PooledEvent<RelocationNotifyEvent>
 {
     public:
-        RelocationNotifyEvent(Unit& owner) : BasicEvent(), m_owner(owner)
+        RelocationNotifyEvent(Unit& owner) : PooledEvent<RelocationNotifyEvent>(), m_owner(owner)
         {
             m_owner._SetAINotifyScheduled(true);
         }
@@ -37,6 +37,7 @@
 #include "MotionGenerators/FollowerReference.h"
 #include "MotionGenerators/FollowerRefManager.h"
 #include "Utilities/EventProcessor.h"
+#include "Utilities/SlotList.h"
 #include "MotionGenerators/MotionMaster.h"
 #include "Server/DBCStructure.h"
 #include "WorldPacket.h"
@@ -1261,7 +1262,7 @@ class Unit : public WorldObject
         typedef std::pair<SpellAuraHolderMap::iterator, SpellAuraHolderMap::iterator> SpellAuraHolderBounds;
         typedef std::pair<SpellAuraHolderMap::const_iterator, SpellAuraHolderMap::const_iterator> SpellAuraHolderConstBounds;
         typedef std::list<SpellAuraHolder*> SpellAuraHolderList;
-        typedef std::list<Aura*> AuraList;
+        typedef SlotList<Aura*> AuraList;
         typedef std::list<DiminishingReturn> Diminishing;
         typedef std::set<uint32 /*playerGuidLow*/> ComboPointHolderSet;
         typedef std::map<uint8 /*slot*/, uint32 /*spellId*/> VisibleAuraMap;
@@ -2143,6 +2144,9 @@ class Unit : public WorldObject
 
         SpellAuraHolderMap&       GetSpellAuraHolderMap()       { return m_spellAuraHolders; }
         SpellAuraHolderMap const& GetSpellAuraHolderMap() const { return m_spellAuraHolders; }
+        // changes when holders are added or removed, auras are applied or removed or a permanent holder gets a duration
+        uint32 GetSpellAuraHoldersVersion() const { return m_spellAuraHoldersVersion; }
+        void ChangeSpellAuraHoldersVersion() { ++m_spellAuraHoldersVersion; }
         AuraList const& GetAurasByType(AuraType type) const { return m_modAuras[type]; }
         void ApplyAuraProcTriggerDamage(Aura* aura, bool apply);
 
@@ -2214,6 +2218,9 @@ class Unit : public WorldObject
         uint32 MeleeDamageBonusTaken(Unit* pCaster, uint32 pdamage, WeaponAttackType attType, SpellEntry const* spellProto = nullptr, DamageEffectType damagetype = DIRECT_DAMAGE, uint32 stack = 1);
 
         bool IsTriggeredAtSpellProcEvent(Unit* pVictim, SpellAuraHolder* holder, SpellEntry const* procSpell, uint32 procFlag, uint32 procExtra, WeaponAttackType attType, bool isVictim, SpellProcEventEntry const*& spellProcEvent, bool dontTriggerSpecial);
+        void AddProcAuraHolder(SpellAuraHolder* holder);
+        void RemoveProcAuraHolder(SpellAuraHolder* holder);
+        void RebuildProcAuraHolders();
         // Aura proc handlers
         SpellAuraProcResult HandleDummyAuraProc(Unit* pVictim, uint32 damage, Aura* triggeredByAura, SpellEntry const* procSpell, uint32 procFlag, uint32 procEx, uint32 cooldown);
         SpellAuraProcResult HandleHasteAuraProc(Unit* pVictim, uint32 damage, Aura* triggeredByAura, SpellEntry const* procSpell, uint32 procFlag, uint32 procEx, uint32 cooldown);
@@ -2393,6 +2400,21 @@ class Unit : public WorldObject
 
         SpellAuraHolderMap m_spellAuraHolders;
         SpellAuraHolderMap::iterator m_spellAuraHoldersUpdateIterator; // != end() in Unit::m_spellAuraHolders update and point to next element
+        uint32 m_spellAuraHoldersVersion;
+
+        // holders ProcDamageAndSpellFor can act on, in the order of m_spellAuraHolders
+        struct ProcAuraHolder
+        {
+            ProcAuraHolder(SpellAuraHolder* holder, uint32 procFlags, bool interruptedByDamage) :
+                holder(holder), procFlags(procFlags), interruptedByDamage(interruptedByDamage) {}
+
+            SpellAuraHolder* holder;
+            uint32 procFlags;                               // PROC_FLAG_* the holder can trigger at
+            bool interruptedByDamage;                       // removed at damage taken without proc
+        };
+        typedef std::vector<ProcAuraHolder> ProcAuraHolderList;
+        ProcAuraHolderList m_procAuraHolders;
+        uint32 m_procAuraHoldersVersion;                    // SpellMgr proc events version the flags were taken at
         AuraList m_deletedAuras;                            // auras removed while in ApplyModifier and waiting deleted
         SpellAuraHolderList m_deletedHolders;
 
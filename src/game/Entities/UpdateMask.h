@@ -21,6 +21,10 @@
 
 #include "Errors.h"
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 class UpdateMask
 {
     public:
@@ -34,20 +38,56 @@ class UpdateMask
 
         void SetBit(uint32 index)
         {
-            ((uint8*)mUpdateMask)[ index >> 3 ] |= 1 << (index & 0x7);
+            mUpdateMask[index >> 5] |= 1u << (index & 31);
+        }
+
+        // sets the bit and returns false if it was already set
+        bool TrySetBit(uint32 index)
+        {
+            uint32& block = mUpdateMask[index >> 5];
+            uint32 bit = 1u << (index & 31);
+            if (block & bit)
+                return false;
+
+            block |= bit;
+            return true;
         }
 
         void UnsetBit(uint32 index)
         {
-            ((uint8*)mUpdateMask)[ index >> 3 ] &= (0xff ^ (1 << (index & 0x7)));
+            mUpdateMask[index >> 5] &= ~(1u << (index & 31));
         }
 
         bool GetBit(uint32 index) const
         {
-            return (((uint8*)mUpdateMask)[ index >> 3 ] & (1 << (index & 0x7))) != 0;
+            return (mUpdateMask[index >> 5] & (1u << (index & 31))) != 0;
+        }
+
+        // first set bit at or after index, GetCount() if there is none
+        uint32 GetNextSetBit(uint32 index) const
+        {
+            if (index >= mCount)
+                return mCount;
+
+            uint32 block = index >> 5;
+            uint32 bits = mUpdateMask[block] & (~0u << (index & 31));
+            for (;;)
+            {
+                if (bits)
+                {
+                    uint32 next = (block << 5) + FindFirstSetBit(bits);
+                    return next < mCount ? next : mCount;
+                }
+
+                if (++block >= mBlocks)
+                    return mCount;
+
+                bits = mUpdateMask[block];
+            }
         }
 
         uint32 GetBlockCount() const { return mBlocks; }
+        uint32 GetBlock(uint32 block) const { return mUpdateMask[block]; }
         uint32 GetLength() const { return mBlocks << 2; }
         uint32 GetCount() const { return mCount; }
         uint8* GetMask() { return (uint8*)mUpdateMask; }
@@ -114,6 +154,18 @@ class UpdateMask
         }
 
     private:
+        // bits must not be 0
+        static uint32 FindFirstSetBit(uint32 bits)
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward(&index, bits);
+            return index;
+#else
+            return __builtin_ctz(bits);
+#endif
+        }
+
         uint32 mCount;
         uint32 mBlocks;
         uint32* mUpdateMask;
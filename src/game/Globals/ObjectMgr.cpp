@@ -1300,8 +1300,9 @@ void ObjectMgr::LoadCreatureModelRace()
 void ObjectMgr::LoadCreatures()
 {
     uint32 count = 0;
-    //                                                0                       1   2    3
-    QueryResult* result = WorldDatabase.Query("SELECT creature.guid, creature.id, map, modelid,"
+    static SqlStatementID selCreatures;
+    //                                                                                0                       1   2    3
+    QueryResult* result = WorldDatabase.CreateStatement(selCreatures, "SELECT creature.guid, creature.id, map, modelid,"
                           //   4             5           6           7           8            9             10                   11           12
                           "equipment_id, position_x, position_y, position_z, orientation, spawntimesecsmin, spawntimesecsmax, spawndist, currentwaypoint,"
                           //   13         14       15          16            17         18         19
@@ -1311,7 +1312,7 @@ void ObjectMgr::LoadCreatures()
                           "FROM creature "
                           "LEFT OUTER JOIN game_event_creature ON creature.guid = game_event_creature.guid "
                           "LEFT OUTER JOIN pool_creature ON creature.guid = pool_creature.guid "
-                          "LEFT OUTER JOIN pool_creature_template ON creature.id = pool_creature_template.id");
+                          "LEFT OUTER JOIN pool_creature_template ON creature.id = pool_creature_template.id").StreamQuery();
 
     if (!result)
     {
@@ -1338,7 +1339,8 @@ void ObjectMgr::LoadCreatures()
                 if (GetMapDifficultyData(i, Difficulty(k)))
                     spawnMasks[i] |= (1 << k);
 
-    BarGoLink bar(result->GetRowCount());
+    // a streamed result does not know its row count
+    BarGoLink bar(WorldDatabase.GetTableRowCount("creature"));
 
     do
     {
@@ -1532,8 +1534,9 @@ void ObjectMgr::LoadGameObjects()
 {
     uint32 count = 0;
 
-    //                                                0                           1   2    3           4           5           6
-    QueryResult* result = WorldDatabase.Query("SELECT gameobject.guid, gameobject.id, map, position_x, position_y, position_z, orientation,"
+    static SqlStatementID selGameObjects;
+    //                                                                                  0                           1   2    3           4           5           6
+    QueryResult* result = WorldDatabase.CreateStatement(selGameObjects, "SELECT gameobject.guid, gameobject.id, map, position_x, position_y, position_z, orientation,"
                           //   7          8          9          10         11                 12               13         14       15         16      17
                           "rotation0, rotation1, rotation2, rotation3, spawntimesecsmin, spawntimesecsmax, animprogress, state, spawnMask, phaseMask, event,"
                           //   18                          19
@@ -1541,7 +1544,7 @@ void ObjectMgr::LoadGameObjects()
                           "FROM gameobject "
                           "LEFT OUTER JOIN game_event_gameobject ON gameobject.guid = game_event_gameobject.guid "
                           "LEFT OUTER JOIN pool_gameobject ON gameobject.guid = pool_gameobject.guid "
-                          "LEFT OUTER JOIN pool_gameobject_template ON gameobject.id = pool_gameobject_template.id");
+                          "LEFT OUTER JOIN pool_gameobject_template ON gameobject.id = pool_gameobject_template.id").StreamQuery();
 
     if (!result)
     {
@@ -1560,7 +1563,8 @@ void ObjectMgr::LoadGameObjects()
                 if (GetMapDifficultyData(i, Difficulty(k)))
                     spawnMasks[i] |= (1 << k);
 
-    BarGoLink bar(result->GetRowCount());
+    // a streamed result does not know its row count
+    BarGoLink bar(WorldDatabase.GetTableRowCount("gameobject"));
 
     do
     {
@@ -39,31 +39,29 @@ void VisibleChangesNotifier::Visit(CameraMapType& m)
 void VisibleNotifier::Notify()
 {
     Player& player = *i_camera.GetOwner();
-    // at this moment i_clientGUIDs have guids that not iterate at grid level checks
+    // at this moment i_clientGUIDs have guids not visited at grid level checks
     // but exist one case when this possible and object not out of range: transports
     if (Transport* transport = player.GetTransport())
     {
         for (Transport::PlayerSet::const_iterator itr = transport->GetPassengers().begin(); itr != transport->GetPassengers().end(); ++itr)
         {
-            if (i_clientGUIDs.find((*itr)->GetObjectGuid()) != i_clientGUIDs.end())
+            if (i_clientGUIDs.MarkVisited((*itr)->GetObjectGuid()))
             {
                 // ignore far sight case
                 (*itr)->UpdateVisibilityOf(*itr, &player);
                 player.UpdateVisibilityOf(&player, *itr, i_data, i_visibleNow);
-                i_clientGUIDs.erase((*itr)->GetObjectGuid());
             }
         }
     }
 
-    // generate outOfRange for not iterate objects
-    i_data.AddOutOfRangeGUID(i_clientGUIDs);
-    for (GuidSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end(); ++itr)
+    // generate outOfRange for not visited objects
+    i_clientGUIDs.EraseNotVisited([&](ObjectGuid const& guid)
     {
-        player.m_clientGUIDs.erase(*itr);
+        i_data.AddOutOfRangeGUID(guid);
 
         DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "%s is out of range (no in active cells set) now for %s",
-                         itr->GetString().c_str(), player.GetGuidStr().c_str());
-    }
+                         guid.GetString().c_str(), player.GetGuidStr().c_str());
+    });
 
     if (i_data.HasData())
     {
@@ -107,7 +105,7 @@ void MessageDeliverer::Visit(CameraMapType& m)
                 continue;
 
             if (WorldSession* session = owner->GetSession())
-                session->SendPacket(i_message);
+                i_message.SendTo(*session);
         }
     }
 }
@@ -122,7 +120,7 @@ void MessageDelivererExcept::Visit(CameraMapType& m)
             continue;
 
         if (WorldSession* session = owner->GetSession())
-            session->SendPacket(i_message);
+            i_message.SendTo(*session);
     }
 }
 
@@ -134,7 +132,7 @@ void ObjectMessageDeliverer::Visit(CameraMapType& m)
             continue;
 
         if (WorldSession* session = iter->getSource()->GetOwner()->GetSession())
-            session->SendPacket(i_message);
+            i_message.SendTo(*session);
     }
 }
 
@@ -152,7 +150,7 @@ void MessageDistDeliverer::Visit(CameraMapType& m)
                 continue;
 
             if (WorldSession* session = owner->GetSession())
-                session->SendPacket(i_message);
+                i_message.SendTo(*session);
         }
     }
 }
@@ -167,7 +165,7 @@ void ObjectMessageDistDeliverer::Visit(CameraMapType& m)
                 continue;
 
             if (WorldSession* session = iter->getSource()->GetOwner()->GetSession())
-                session->SendPacket(i_message);
+                i_message.SendTo(*session);
         }
     }
 }
@@ -36,10 +36,10 @@ namespace MaNGOS
     {
         Camera& i_camera;
         UpdateData i_data;
-        GuidSet i_clientGUIDs;
+        ClientGuidSet& i_clientGUIDs;
         std::set<WorldObject*> i_visibleNow;
 
-        explicit VisibleNotifier(Camera& c) : i_camera(c), i_clientGUIDs(c.GetOwner()->m_clientGUIDs) {}
+        explicit VisibleNotifier(Camera& c) : i_camera(c), i_clientGUIDs(c.GetOwner()->m_clientGUIDs) { i_clientGUIDs.BeginVisit(); }
         template<class T> void Visit(GridRefManager<T>& m);
         void Visit(CameraMapType& /*m*/) {}
         void Notify(void);
@@ -57,7 +57,7 @@ namespace MaNGOS
     struct MessageDeliverer
     {
         Player const& i_player;
-        WorldPacket const& i_message;
+        PacketBroadcaster i_message;
         bool i_toSelf;
         MessageDeliverer(Player const& pl, WorldPacket const& msg, bool to_self) : i_player(pl), i_message(msg), i_toSelf(to_self) {}
         void Visit(CameraMapType& m);
@@ -67,7 +67,7 @@ namespace MaNGOS
     struct MessageDelivererExcept
     {
         uint32        i_phaseMask;
-        WorldPacket const & i_message;
+        PacketBroadcaster i_message;
         Player const* i_skipped_receiver;
 
         MessageDelivererExcept(WorldObject const* obj, WorldPacket const& msg, Player const* skipped)
@@ -80,7 +80,7 @@ namespace MaNGOS
     struct ObjectMessageDeliverer
     {
         uint32 i_phaseMask;
-        WorldPacket const& i_message;
+        PacketBroadcaster i_message;
         explicit ObjectMessageDeliverer(WorldObject const& obj, WorldPacket const& msg)
             : i_phaseMask(obj.GetPhaseMask()), i_message(msg) {}
         void Visit(CameraMapType& m);
@@ -90,7 +90,7 @@ namespace MaNGOS
     struct MessageDistDeliverer
     {
         Player const& i_player;
-        WorldPacket const& i_message;
+        PacketBroadcaster i_message;
         bool i_toSelf;
         bool i_ownTeamOnly;
         float i_dist;
@@ -104,7 +104,7 @@ namespace MaNGOS
     struct ObjectMessageDistDeliverer
     {
         WorldObject const& i_object;
-        WorldPacket const& i_message;
+        PacketBroadcaster i_message;
         float i_dist;
         ObjectMessageDistDeliverer(WorldObject const& obj, WorldPacket const& msg, float dist) : i_object(obj), i_message(msg), i_dist(dist) {}
         void Visit(CameraMapType& m);
@@ -122,6 +122,24 @@ namespace MaNGOS
         void Visit(CreatureMapType&);
     };
 
+    // worker thread part of the parallel cell update: only creatures with a local update, the others are collected
+    struct LocalCreatureUpdater
+    {
+        uint32 i_timeDiff;
+        std::vector<Creature*>& i_skipped;
+        LocalCreatureUpdater(const uint32& diff, std::vector<Creature*>& skipped) : i_timeDiff(diff), i_skipped(skipped) {}
+        template<class T> void Visit(GridRefManager<T>&) {}
+        void Visit(CreatureMapType&);
+    };
+
+    // serial part of the parallel cell update: all but the creatures
+    struct NonCreatureObjectUpdater : public ObjectUpdater
+    {
+        explicit NonCreatureObjectUpdater(const uint32& diff) : ObjectUpdater(diff) {}
+        using ObjectUpdater::Visit;
+        void Visit(CreatureMapType&) {}
+    };
+
     struct PlayerRelocationNotifier
     {
         Player& i_player;
@@ -35,7 +35,7 @@ inline void MaNGOS::VisibleNotifier::Visit(GridRefManager<T>& m)
     for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         i_camera.UpdateVisibilityOf(iter->getSource(), i_data, i_visibleNow);
-        i_clientGUIDs.erase(iter->getSource()->GetObjectGuid());
+        i_clientGUIDs.MarkVisited(iter->getSource()->GetObjectGuid());
     }
 }
 
@@ -48,6 +48,22 @@ inline void MaNGOS::ObjectUpdater::Visit(CreatureMapType& m)
     }
 }
 
+inline void MaNGOS::LocalCreatureUpdater::Visit(CreatureMapType& m)
+{
+    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        Creature* creature = iter->getSource();
+        if (!creature->IsLocalUpdate(i_timeDiff))
+        {
+            i_skipped.push_back(creature);
+            continue;
+        }
+
+        WorldObject::UpdateHelper helper(creature);
+        helper.Update(i_timeDiff);
+    }
+}
+
 inline void PlayerCreatureRelocationWorker(Player* pl, Creature* c)
 {
     // Creature AI reaction
@@ -631,10 +631,19 @@ void Group::UpdatePlayerOutOfRange(Player* pPlayer)
     WorldPacket data;
     pPlayer->GetSession()->BuildPartyMemberStatsChangedPacket(pPlayer, data);
 
+    // visibility of members on other maps is only known to the thread of their map
     for (GroupReference* itr = GetFirstMember(); itr != nullptr; itr = itr->next())
-        if (Player* player = itr->getSource())
-            if (player != pPlayer && !player->HaveAtClient(pPlayer))
-                player->GetSession()->SendPacket(data);
+    {
+        Player* player = itr->getSource();
+        if (!player || player == pPlayer)
+            continue;
+
+        Map* map = player->IsInWorld() ? player->GetMap() : nullptr;
+        if (map && map != pPlayer->GetMap())
+            map->AddOutOfRangeMemberStats(player->GetObjectGuid(), pPlayer->GetObjectGuid(), data);
+        else if (!player->HaveAtClient(pPlayer))
+            player->GetSession()->SendPacket(data);
+    }
 }
 
 void Group::UpdatePlayerOnlineStatus(Player* player, bool online /*= true*/)
@@ -101,12 +101,15 @@ void LootStore::LoadLootTable()
     // Clearing store (for reloading case)
     Clear();
 
-    //                                                 0      1     2                    3        4              5         6
-    QueryResult* result = WorldDatabase.PQuery("SELECT entry, item, ChanceOrQuestChance, groupid, mincountOrRef, maxcount, condition_id FROM %s", GetName());
+    // a streamed result does not know its row count
+    uint32 rowCount = WorldDatabase.GetTableRowCount(GetName());
+
+    //                                                       0      1     2                    3        4              5         6
+    QueryResult* result = WorldDatabase.PStreamQuery("SELECT entry, item, ChanceOrQuestChance, groupid, mincountOrRef, maxcount, condition_id FROM %s", GetName());
 
     if (result)
     {
-        BarGoLink bar(result->GetRowCount());
+        BarGoLink bar(rowCount);
 
         do
         {
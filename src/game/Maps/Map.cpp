@@ -76,10 +76,10 @@ void Map::LoadMapAndVMap(int gx, int gy)
 Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
     : i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode),
       i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0),
-      m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(nullptr),
-      m_activeNonPlayersIter(m_activeNonPlayers.end()),
-      i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
-      i_data(nullptr), i_script_id(0)
+      m_lastUpdateTime(0), m_averageUpdateTime(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(nullptr),
+      i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)), m_activeCellRadius(0),
+      i_data(nullptr), i_script_id(0),
+      m_parallelCellUpdate(false), m_cellUpdateStripWidth(1)
 {
     m_CreatureGuids.Set(sObjectMgr.GetFirstTemporaryCreatureLowGuid());
     m_GameObjectGuids.Set(sObjectMgr.GetFirstTemporaryGameObjectLowGuid());
@@ -208,6 +208,8 @@ void Map::DeleteFromWorld(Player* pl)
 void
 Map::EnsureGridCreated(const GridPair& p)
 {
+    CellUpdateGuard guard = LockCellUpdate();
+
     if (!getNGrid(p.x_coord, p.y_coord))
     {
         setNGrid(new NGridType(p.x_coord * MAX_NUMBER_OF_GRIDS + p.y_coord, p.x_coord, p.y_coord, i_gridExpiry, sWorld.getConfig(CONFIG_BOOL_GRID_UNLOAD)),
@@ -257,6 +259,8 @@ Map::EnsureGridLoadedAtEnter(const Cell& cell, Player* player)
 
 bool Map::EnsureGridLoaded(const Cell& cell)
 {
+    CellUpdateGuard guard = LockCellUpdate();
+
     EnsureGridCreated(GridPair(cell.GridX(), cell.GridY()));
     NGridType* grid = getNGrid(cell.GridX(), cell.GridY());
 
@@ -301,6 +305,7 @@ bool Map::Add(Player* player)
     Cell cell(p);
     EnsureGridLoadedAtEnter(cell, player);
     player->AddToWorld();
+    AddActiveCellSource(player);
 
     SendInitSelf(player);
     SendInitTransports(player);
@@ -328,6 +333,8 @@ Map::Add(T* obj)
         return;
     }
 
+    CellUpdateGuard guard = LockCellUpdate();
+
     obj->SetMap(this);
 
     Cell cell(p);
@@ -448,6 +455,8 @@ void Map::Update(const uint32& t_diff)
 {
     m_dyn_tree.update(t_diff);
 
+    SendOutOfRangeMemberStats();
+
     /// update worldsessions for existing players
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
@@ -473,110 +482,207 @@ void Map::Update(const uint32& t_diff)
     }
 
     /// update active cells around players and active objects
-    resetMarkedCells();
+    if (m_activeCellRadius != uint32(ceil(GetVisibilityDistance() / SIZE_OF_GRID_CELL)))
+        RebuildActiveCells();
+
+    std::vector<uint32> cells;
+    cells.reserve(m_activeCells.size());
+    for (ActiveCellRefs::const_iterator itr = m_activeCells.begin(); itr != m_activeCells.end(); ++itr)
+        cells.push_back(itr->first);
+
+    if (IsContinent() && sMapMgr.GetCellUpdatePool())
+        UpdateCellsInParallel(cells, t_diff);
+    else
+        UpdateCells(cells, t_diff);
+
+    // Send world objects and item update field changes
+    SendObjectUpdates();
+
+    // Don't unload grids if it's battleground, since we may have manually added GOs,creatures, those doesn't load from DB at grid re-load !
+    // This isn't really bother us, since as soon as we have instanced BG-s, the whole map unloads as the BG gets ended
+    if (!IsBattleGroundOrArena())
+    {
+        for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end();)
+        {
+            NGridType* grid = i->getSource();
+            GridInfo* info = i->getSource()->getGridInfoRef();
+            ++i;                                            // The update might delete the map and we need the next map before the iterator gets invalid
+            MANGOS_ASSERT(grid->GetGridState() >= 0 && grid->GetGridState() < MAX_GRID_STATE);
+            sMapMgr.UpdateGridState(grid->GetGridState(), *this, *grid, *info, grid->getX(), grid->getY(), t_diff);
+        }
+    }
+
+    ///- Process necessary scripts
+    if (!m_scriptSchedule.empty())
+        ScriptsProcess();
+
+    if (i_data)
+        i_data->Update(t_diff);
+
+    m_weatherSystem->UpdateWeathers(t_diff);
+}
+
+void Map::AddActiveCellSource(WorldObject const* obj)
+{
+    CellPair center = MaNGOS::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY());
+    if (center.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || center.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
+        return;
+
+    if (m_activeCellSources.insert(ActiveCellSources::value_type(obj, center)).second)
+        ModifyActiveCellRefs(center, nullptr, 1);
+}
 
-    MaNGOS::ObjectUpdater updater(t_diff);
+void Map::RemoveActiveCellSource(WorldObject const* obj)
+{
+    ActiveCellSources::iterator itr = m_activeCellSources.find(obj);
+    if (itr == m_activeCellSources.end())
+        return;
+
+    ModifyActiveCellRefs(itr->second, nullptr, -1);
+    m_activeCellSources.erase(itr);
+}
+
+void Map::MoveActiveCellSource(WorldObject const* obj, CellPair const& center)
+{
+    // active creatures may change cells from inside the parallel cell update
+    CellUpdateGuard guard = LockCellUpdate();
+
+    ActiveCellSources::iterator itr = m_activeCellSources.find(obj);
+    if (itr == m_activeCellSources.end() || itr->second == center)
+        return;
+
+    // only the cells not covered from both positions change
+    ModifyActiveCellRefs(itr->second, &center, -1);
+    ModifyActiveCellRefs(center, &itr->second, 1);
+    itr->second = center;
+}
+
+void Map::ModifyActiveCellRefs(CellPair const& center, CellPair const* skipCenter, int32 diff)
+{
+    uint32 const radius = m_activeCellRadius;
+    uint32 const lowX = center.x_coord > radius ? center.x_coord - radius : 0;
+    uint32 const lowY = center.y_coord > radius ? center.y_coord - radius : 0;
+    uint32 const highX = std::min(center.x_coord + radius, uint32(TOTAL_NUMBER_OF_CELLS_PER_MAP - 1));
+    uint32 const highY = std::min(center.y_coord + radius, uint32(TOTAL_NUMBER_OF_CELLS_PER_MAP - 1));
+
+    for (uint32 x = lowX; x <= highX; ++x)
+    {
+        for (uint32 y = lowY; y <= highY; ++y)
+        {
+            if (skipCenter && std::max(x, skipCenter->x_coord) - std::min(x, skipCenter->x_coord) <= radius &&
+                    std::max(y, skipCenter->y_coord) - std::min(y, skipCenter->y_coord) <= radius)
+                continue;
+
+            uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+            if (diff > 0)
+                ++m_activeCells[cell_id];
+            else
+            {
+                ActiveCellRefs::iterator itr = m_activeCells.find(cell_id);
+                MANGOS_ASSERT(itr != m_activeCells.end());
+                if (!--itr->second)
+                    m_activeCells.erase(itr);
+            }
+        }
+    }
+}
+
+void Map::RebuildActiveCells()
+{
+    // the area around each source depends on the visibility distance
+    m_activeCellRadius = uint32(ceil(GetVisibilityDistance() / SIZE_OF_GRID_CELL));
+
+    m_activeCells.clear();
+    for (ActiveCellSources::const_iterator itr = m_activeCellSources.begin(); itr != m_activeCellSources.end(); ++itr)
+        ModifyActiveCellRefs(itr->second, nullptr, 1);
+}
+
+void Map::UpdateCells(std::vector<uint32> const& cells, uint32 diff)
+{
+    MaNGOS::ObjectUpdater updater(diff);
     // for creature
     TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
     // for pets
     TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
 
-    // the player iterator is stored in the map object
-    // to make sure calls to Map::Remove don't invalidate it
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    for (std::vector<uint32>::const_iterator itr = cells.begin(); itr != cells.end(); ++itr)
     {
-        Player* plr = m_mapRefIter->getSource();
+        CellPair pair(*itr % TOTAL_NUMBER_OF_CELLS_PER_MAP, *itr / TOTAL_NUMBER_OF_CELLS_PER_MAP);
+        Cell cell(pair);
+        cell.SetNoCreate();
+        Visit(cell, grid_object_update);
+        Visit(cell, world_object_update);
+    }
+}
 
-        if (!plr->IsInWorld() || !plr->IsPositionValid())
-            continue;
+void Map::UpdateCellsInParallel(std::vector<uint32> const& cells, uint32 diff)
+{
+    // a strip must be wider than the reach of objects from both neighbour strips
+    m_cellUpdateStripWidth = std::max(uint32(ceil(2.0f * GetVisibilityDistance() / SIZE_OF_GRIDS)), uint32(1));
 
-        // lets update mobs/objects in ALL visible cells around player!
-        CellArea area = Cell::CalculateCellArea(plr->GetPositionX(), plr->GetPositionY(), GetVisibilityDistance());
+    std::vector<std::vector<uint32> > strips(MAX_NUMBER_OF_GRIDS / m_cellUpdateStripWidth + 1);
+    for (std::vector<uint32>::const_iterator itr = cells.begin(); itr != cells.end(); ++itr)
+        strips[GetCellUpdateStrip(*itr % TOTAL_NUMBER_OF_CELLS_PER_MAP / MAX_NUMBER_OF_CELLS)].push_back(*itr);
 
-        for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+    MaNGOS::ThreadPool* pool = sMapMgr.GetCellUpdatePool();
+
+    // creatures which can't touch anything but themselves, even strips first, then odd strips
+    std::vector<std::vector<Creature*> > skipped(strips.size());
+    m_parallelCellUpdate = true;
+    for (uint32 phase = 0; phase < 2; ++phase)
+    {
+        MaNGOS::ThreadPool::TaskGroup group;
+        for (uint32 i = phase; i < strips.size(); i += 2)
         {
-            for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+            if (strips[i].empty())
+                continue;
+
+            std::vector<uint32> const* strip = &strips[i];
+            std::vector<Creature*>* stripSkipped = &skipped[i];
+            pool->Enqueue(group, [this, strip, stripSkipped, diff]()
             {
-                // marked cells are those that have been visited
-                // don't visit the same cell twice
-                uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-                if (!isCellMarked(cell_id))
+                MaNGOS::LocalCreatureUpdater updater(diff, *stripSkipped);
+                TypeContainerVisitor<MaNGOS::LocalCreatureUpdater, GridTypeMapContainer> grid_object_update(updater);
+
+                for (std::vector<uint32>::const_iterator itr = strip->begin(); itr != strip->end(); ++itr)
                 {
-                    markCell(cell_id);
-                    CellPair pair(x, y);
+                    CellPair pair(*itr % TOTAL_NUMBER_OF_CELLS_PER_MAP, *itr / TOTAL_NUMBER_OF_CELLS_PER_MAP);
                     Cell cell(pair);
                     cell.SetNoCreate();
                     Visit(cell, grid_object_update);
-                    Visit(cell, world_object_update);
                 }
-            }
+            });
         }
+        pool->Wait(group);
     }
+    m_parallelCellUpdate = false;
 
-    // non-player active objects
-    if (!m_activeNonPlayers.empty())
+    // all other creatures, gameobjects, dynamic objects, pets and corpses stay with the serial update
+    for (std::vector<std::vector<Creature*> >::const_iterator strip = skipped.begin(); strip != skipped.end(); ++strip)
     {
-        for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+        for (std::vector<Creature*>::const_iterator itr = strip->begin(); itr != strip->end(); ++itr)
         {
-            // skip not in world
-            WorldObject* obj = *m_activeNonPlayersIter;
-
-            // step before processing, in this case if Map::Remove remove next object we correctly
-            // step to next-next, and if we step to end() then newly added objects can wait next update.
-            ++m_activeNonPlayersIter;
-
-            if (!obj->IsInWorld() || !obj->IsPositionValid())
-                continue;
-
-            // lets update mobs/objects in ALL visible cells around player!
-            CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), GetVisibilityDistance());
-
-            for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+            // removed objects are only deleted after the map update
+            if ((*itr)->IsInWorld())
             {
-                for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
-                {
-                    // marked cells are those that have been visited
-                    // don't visit the same cell twice
-                    uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-                    if (!isCellMarked(cell_id))
-                    {
-                        markCell(cell_id);
-                        CellPair pair(x, y);
-                        Cell cell(pair);
-                        cell.SetNoCreate();
-                        Visit(cell, grid_object_update);
-                        Visit(cell, world_object_update);
-                    }
-                }
+                WorldObject::UpdateHelper helper(*itr);
+                helper.Update(diff);
             }
         }
     }
 
-    // Send world objects and item update field changes
-    SendObjectUpdates();
-
-    // Don't unload grids if it's battleground, since we may have manually added GOs,creatures, those doesn't load from DB at grid re-load !
-    // This isn't really bother us, since as soon as we have instanced BG-s, the whole map unloads as the BG gets ended
-    if (!IsBattleGroundOrArena())
+    MaNGOS::NonCreatureObjectUpdater grid_updater(diff);
+    TypeContainerVisitor<MaNGOS::NonCreatureObjectUpdater, GridTypeMapContainer> grid_object_update(grid_updater);
+    MaNGOS::ObjectUpdater updater(diff);
+    TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer> world_object_update(updater);
+    for (std::vector<uint32>::const_iterator itr = cells.begin(); itr != cells.end(); ++itr)
     {
-        for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end();)
-        {
-            NGridType* grid = i->getSource();
-            GridInfo* info = i->getSource()->getGridInfoRef();
-            ++i;                                            // The update might delete the map and we need the next map before the iterator gets invalid
-            MANGOS_ASSERT(grid->GetGridState() >= 0 && grid->GetGridState() < MAX_GRID_STATE);
-            sMapMgr.UpdateGridState(grid->GetGridState(), *this, *grid, *info, grid->getX(), grid->getY(), t_diff);
-        }
+        CellPair pair(*itr % TOTAL_NUMBER_OF_CELLS_PER_MAP, *itr / TOTAL_NUMBER_OF_CELLS_PER_MAP);
+        Cell cell(pair);
+        cell.SetNoCreate();
+        Visit(cell, grid_object_update);
+        Visit(cell, world_object_update);
     }
-
-    ///- Process necessary scripts
-    if (!m_scriptSchedule.empty())
-        ScriptsProcess();
-
-    if (i_data)
-        i_data->Update(t_diff);
-
-    m_weatherSystem->UpdateWeathers(t_diff);
 }
 
 void Map::Remove(Player* player, bool remove)
@@ -597,6 +703,7 @@ void Map::Remove(Player* player, bool remove)
     if (m_mapRefIter == player->GetMapRef())
         m_mapRefIter = m_mapRefIter->nocheck_prev();
     player->GetMapRef().unlink();
+    RemoveActiveCellSource(player);
     CellPair p = MaNGOS::ComputeCellPair(player->GetPositionX(), player->GetPositionY());
     if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
     {
@@ -642,6 +749,8 @@ Map::Remove(T* obj, bool remove)
         return;
     }
 
+    CellUpdateGuard guard = LockCellUpdate();
+
     Cell cell(p);
     if (!loaded(GridPair(cell.data.Part.grid_x, cell.data.Part.grid_y)))
         return;
@@ -700,6 +809,8 @@ Map::PlayerRelocation(Player* player, float x, float y, float z, float orientati
 
         NGridType* newGrid = getNGrid(new_cell.GridX(), new_cell.GridY());
         player->GetViewPoint().Event_GridChanged(&(*newGrid)(new_cell.CellX(), new_cell.CellY()));
+
+        MoveActiveCellSource(player, new_val);
     }
 
     player->OnRelocated();
@@ -757,6 +868,9 @@ bool Map::CreatureCellRelocation(Creature* c, const Cell& new_cell)
         RemoveFromGrid(c, oldGrid, old_cell);
         AddToGrid(c, newGrid, new_cell);
         c->GetViewPoint().Event_GridChanged(&(*newGrid)(new_cell.CellX(), new_cell.CellY()));
+
+        if (c->isActiveObject())
+            MoveActiveCellSource(c, new_cell.cellPair());
     }
     return true;
 }
@@ -995,6 +1109,7 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 
     obj->CleanupsBeforeDelete();                            // remove or simplify at least cross referenced links
 
+    CellUpdateGuard guard = LockCellUpdate();
     i_objectsToRemove.insert(obj);
     // DEBUG_LOG("Object (GUID: %u TypeId: %u ) added to removing list.",obj->GetGUIDLow(),obj->GetTypeId());
 }
@@ -1050,18 +1165,20 @@ uint32 Map::GetPlayersCountExceptGMs() const
 
 void Map::SendToPlayers(WorldPacket const& data) const
 {
+    PacketBroadcaster broadcaster(data);
     for (MapRefManager::const_iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
-        itr->getSource()->GetSession()->SendPacket(data);
+        broadcaster.SendTo(*itr->getSource()->GetSession());
 }
 
 bool Map::SendToPlayersInZone(WorldPacket const& data, uint32 zoneId) const
 {
+    PacketBroadcaster broadcaster(data);
     bool foundPlayer = false;
     for (MapRefManager::const_iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
     {
         if (itr->getSource()->GetZoneId() == zoneId)
         {
-            itr->getSource()->GetSession()->SendPacket(data);
+            broadcaster.SendTo(*itr->getSource()->GetSession());
             foundPlayer = true;
         }
     }
@@ -1110,7 +1227,10 @@ bool Map::ActiveObjectsNearGrid(uint32 x, uint32 y) const
 
 void Map::AddToActive(WorldObject* obj)
 {
+    CellUpdateGuard guard = LockCellUpdate();
+
     m_activeNonPlayers.insert(obj);
+    AddActiveCellSource(obj);
     Cell cell = Cell(MaNGOS::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY()));
     EnsureGridLoaded(cell);
 
@@ -1138,16 +1258,10 @@ void Map::AddToActive(WorldObject* obj)
 
 void Map::RemoveFromActive(WorldObject* obj)
 {
-    // Map::Update for active object in proccess
-    if (m_activeNonPlayersIter != m_activeNonPlayers.end())
-    {
-        ActiveNonPlayers::iterator itr = m_activeNonPlayers.find(obj);
-        if (itr == m_activeNonPlayersIter)
-            ++m_activeNonPlayersIter;
-        m_activeNonPlayers.erase(itr);
-    }
-    else
-        m_activeNonPlayers.erase(obj);
+    CellUpdateGuard guard = LockCellUpdate();
+
+    m_activeNonPlayers.erase(obj);
+    RemoveActiveCellSource(obj);
 
     // also allow unloading spawn grid
     if (obj->GetTypeId() == TYPEID_UNIT)
@@ -1636,6 +1750,8 @@ bool Map::ScriptsStart(ScriptMapMapName const& scripts, uint32 id, Object* sourc
     ObjectGuid targetGuid = target ? target->GetObjectGuid() : ObjectGuid();
     ObjectGuid ownerGuid  = source->isType(TYPEMASK_ITEM) ? ((Item*)source)->GetOwnerGuid() : ObjectGuid();
 
+    CellUpdateGuard guard = LockCellUpdate();
+
     if (execParams)                                         // Check if the execution should be uniquely
     {
         for (ScriptScheduleMap::const_iterator searchItr = m_scriptSchedule.begin(); searchItr != m_scriptSchedule.end(); ++searchItr)
@@ -1675,6 +1791,7 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
 
     ScriptAction sa("Internal Activate Command used for spell", this, sourceGuid, targetGuid, ownerGuid, &script);
 
+    CellUpdateGuard guard = LockCellUpdate();
     m_scriptSchedule.insert(ScriptScheduleMap::value_type(time_t(sWorld.GetGameTime() + delay), sa));
 
     sScriptMgr.IncreaseScheduledScriptsCount();
@@ -1729,6 +1846,27 @@ void Map::ScriptsProcess()
  *
  * @param guid must be player guid (HIGHGUID_PLAYER)
  */
+void Map::AddOutOfRangeMemberStats(ObjectGuid receiver, ObjectGuid member, WorldPacket const& data)
+{
+    std::lock_guard<std::mutex> guard(m_memberStatsLock);
+    m_memberStats.push_back({ receiver, member, data });
+}
+
+void Map::SendOutOfRangeMemberStats()
+{
+    std::vector<OutOfRangeMemberStats> memberStats;
+    {
+        std::lock_guard<std::mutex> guard(m_memberStatsLock);
+        memberStats.swap(m_memberStats);
+    }
+
+    // receivers which left this map meanwhile are skipped, the member's next stats change reaches them
+    for (std::vector<OutOfRangeMemberStats>::const_iterator itr = memberStats.begin(); itr != memberStats.end(); ++itr)
+        if (Player* player = GetPlayer(itr->receiver))
+            if (!player->m_clientGUIDs.contains(itr->member))
+                player->GetSession()->SendPacket(itr->data);
+}
+
 Player* Map::GetPlayer(ObjectGuid guid)
 {
     Player* plr = ObjectAccessor::FindPlayer(guid);         // return only in world players
@@ -1742,6 +1880,7 @@ Player* Map::GetPlayer(ObjectGuid guid)
  */
 Creature* Map::GetCreature(ObjectGuid guid)
 {
+    CellUpdateGuard lock = LockCellUpdate();
     return m_objectsStore.find<Creature>(guid, (Creature*)nullptr);
 }
 
@@ -1752,6 +1891,7 @@ Creature* Map::GetCreature(ObjectGuid guid)
  */
 Pet* Map::GetPet(ObjectGuid guid)
 {
+    CellUpdateGuard lock = LockCellUpdate();
     return m_objectsStore.find<Pet>(guid, (Pet*)nullptr);
 }
 
@@ -1793,6 +1933,7 @@ Creature* Map::GetAnyTypeCreature(ObjectGuid guid)
  */
 GameObject* Map::GetGameObject(ObjectGuid guid)
 {
+    CellUpdateGuard lock = LockCellUpdate();
     return m_objectsStore.find<GameObject>(guid, (GameObject*)nullptr);
 }
 
@@ -1803,6 +1944,7 @@ GameObject* Map::GetGameObject(ObjectGuid guid)
  */
 DynamicObject* Map::GetDynamicObject(ObjectGuid guid)
 {
+    CellUpdateGuard lock = LockCellUpdate();
     return m_objectsStore.find<DynamicObject>(guid, (DynamicObject*)nullptr);
 }
 
@@ -1851,26 +1993,95 @@ WorldObject* Map::GetWorldObject(ObjectGuid guid)
 
 void Map::SendObjectUpdates()
 {
-    UpdateDataMapType update_players;
+    if (i_objectsToClientUpdate.empty())
+        return;
+
+    // receivers are collected first, the packets of different players are then independent of each other
+    std::vector<Object*> objects(i_objectsToClientUpdate.begin(), i_objectsToClientUpdate.end());
+    i_objectsToClientUpdate.clear();
 
-    while (!i_objectsToClientUpdate.empty())
+    // objects seen by several players are serialized once for all of them, except for the object itself
+    std::deque<SharedValuesUpdateBlock> sharedBlocks;
+
+    std::unordered_map<Player*, ObjectUpdateList> updatesByPlayer;
+    UpdateReceiverList receivers;
+    for (std::vector<Object*>::const_iterator itr = objects.begin(); itr != objects.end(); ++itr)
     {
-        Object* obj = *i_objectsToClientUpdate.begin();
-        i_objectsToClientUpdate.erase(i_objectsToClientUpdate.begin());
-        obj->BuildUpdateData(update_players);
+        // nothing to send if the changes were cleared meanwhile
+        if (!(*itr)->HasChangedValues())
+            continue;
+
+        receivers.clear();
+        (*itr)->GetUpdateReceivers(receivers);
+
+        SharedValuesUpdateBlock const* sharedBlock = nullptr;
+        if (receivers.size() - std::count(receivers.begin(), receivers.end(), *itr) > 1)
+        {
+            sharedBlocks.push_back(SharedValuesUpdateBlock());
+            (*itr)->BuildSharedValuesUpdateBlock(sharedBlocks.back());
+            sharedBlock = &sharedBlocks.back();
+        }
+
+        for (UpdateReceiverList::const_iterator rItr = receivers.begin(); rItr != receivers.end(); ++rItr)
+            updatesByPlayer[*rItr].push_back(ObjectUpdate(*itr, *rItr != *itr ? sharedBlock : nullptr));
     }
 
+    ObjectUpdateReceiverList updates;
+    updates.reserve(updatesByPlayer.size());
+    for (std::unordered_map<Player*, ObjectUpdateList>::const_iterator itr = updatesByPlayer.begin(); itr != updatesByPlayer.end(); ++itr)
+        updates.push_back(ObjectUpdateReceiver(itr->first, &itr->second));
+
+    // serialize and compress the packets, objects are only read until their masks are cleared below
+    MaNGOS::ThreadPool* pool = sMapMgr.GetObjectUpdatePool();
+    if (pool && updates.size() >= OBJECT_UPDATE_MIN_PLAYERS_PER_TASK * 2)
+    {
+        // a few tasks per worker so an expensive player does not hold back the pass
+        uint32 tasks = std::min(uint32(updates.size() / OBJECT_UPDATE_MIN_PLAYERS_PER_TASK), (pool->GetThreadCount() + 1) * 4);
+        MaNGOS::ThreadPool::TaskGroup group;
+        for (uint32 i = 0; i < tasks; ++i)
+        {
+            size_t begin = updates.size() * i / tasks;
+            size_t end = updates.size() * (i + 1) / tasks;
+            pool->Enqueue(group, [&updates, begin, end]()
+            {
+                SendObjectUpdatesToPlayers(updates, begin, end);
+            });
+        }
+        pool->Wait(group);
+    }
+    else
+        SendObjectUpdatesToPlayers(updates, 0, updates.size());
+
+    for (std::vector<Object*>::const_iterator itr = objects.begin(); itr != objects.end(); ++itr)
+        (*itr)->ClearUpdateMask(false);
+}
+
+void Map::SendObjectUpdatesToPlayers(ObjectUpdateReceiverList const& updates, size_t begin, size_t end)
+{
     WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
-    for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
+    for (size_t i = begin; i < end; ++i)
     {
-        iter->second.BuildPacket(packet);
-        iter->first->GetSession()->SendPacket(packet);
+        Player* player = updates[i].first;
+
+        UpdateData data;
+        for (ObjectUpdateList::const_iterator itr = updates[i].second->begin(); itr != updates[i].second->end(); ++itr)
+        {
+            if (itr->second)
+                itr->first->AddSharedValuesUpdateBlock(&data, *itr->second, player);
+            else
+                itr->first->BuildValuesUpdateBlockForPlayer(&data, player);
+        }
+
+        data.BuildPacket(packet);
+        player->GetSession()->SendPacket(packet);
         packet.clear();                                     // clean the string
     }
 }
 
 uint32 Map::GenerateLocalLowGuid(HighGuid guidhigh)
 {
+    CellUpdateGuard guard = LockCellUpdate();
+
     // TODO: for map local guid counters possible force reload map instead shutdown server at guid counter overflow
     switch (guidhigh)
     {
@@ -1993,8 +2204,11 @@ void Map::PlayDirectSoundToMap(uint32 soundId, uint32 zoneId /*=0*/) const
  */
 bool Map::IsInLineOfSight(float srcX, float srcY, float srcZ, float destX, float destY, float destZ, uint32 phasemask) const
 {
-    return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ)
-           && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, phasemask);
+    if (!VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ))
+        return false;
+
+    CellUpdateGuard guard = LockCellUpdate();
+    return m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, phasemask);
 }
 
 /**
@@ -2014,6 +2228,7 @@ bool Map::GetHitPosition(float srcX, float srcY, float srcZ, float& destX, float
         destZ = tempZ;
     }
     // at second all dynamic objects, if static check has an hit, then we can calculate only to this closer point
+    CellUpdateGuard guard = LockCellUpdate();
     bool result1 = m_dyn_tree.getObjectHitPos(phasemask, srcX, srcY, srcZ, destX, destY, destZ, tempX, tempY, tempZ, modifyDist);
     if (result1)
     {
@@ -2076,6 +2291,7 @@ bool Map::GetHeightInRange(uint32 phasemask, float x, float y, float& z, float m
             return false;
     }
 
+    CellUpdateGuard guard = LockCellUpdate();
     z = std::max<float>(height, m_dyn_tree.getHeight(x, y, height + 1.0f, maxSearchDist, phasemask));
     return true;
 }
@@ -2086,21 +2302,25 @@ float Map::GetHeight(uint32 phasemask, float x, float y, float z) const
 
     // Get Dynamic Height around static Height (if valid)
     float dynSearchHeight = 2.0f + (z < staticHeight ? staticHeight : z);
+    CellUpdateGuard guard = LockCellUpdate();
     return std::max<float>(staticHeight, m_dyn_tree.getHeight(x, y, dynSearchHeight, dynSearchHeight - staticHeight, phasemask));
 }
 
 void Map::InsertGameObjectModel(const GameObjectModel& mdl)
 {
+    CellUpdateGuard guard = LockCellUpdate();
     m_dyn_tree.insert(mdl);
 }
 
 void Map::RemoveGameObjectModel(const GameObjectModel& mdl)
 {
+    CellUpdateGuard guard = LockCellUpdate();
     m_dyn_tree.remove(mdl);
 }
 
 bool Map::ContainsGameObjectModel(const GameObjectModel& mdl) const
 {
+    CellUpdateGuard guard = LockCellUpdate();
     return m_dyn_tree.contains(mdl);
 }
 
@@ -34,8 +34,11 @@
 #include "DBScripts/ScriptMgr.h"
 #include "Entities/CreatureLinkingMgr.h"
 #include "Vmap/DynamicTree.h"
+#include "Combat/ThreatManager.h"
+#include "WorldPacket.h"
 
-#include <bitset>
+#include <mutex>
+#include <unordered_map>
 
 struct CreatureInfo;
 class Creature;
@@ -89,6 +92,7 @@ enum LevelRequirementVsMode
 #endif
 
 #define MIN_UNLOAD_DELAY      1                             // immediate unload
+#define OBJECT_UPDATE_MIN_PLAYERS_PER_TASK  4               // receivers handled by one worker task when sending object updates in parallel
 
 class Map : public GridRefManager<NGridType>
 {
@@ -120,11 +124,28 @@ class Map : public GridRefManager<NGridType>
 
         virtual void Update(const uint32&);
 
+        // time in microseconds spent in Update() calls, measured by MapUpdater
+        uint32 GetLastUpdateTime() const { return m_lastUpdateTime; }
+        uint32 GetAverageUpdateTime() const { return m_averageUpdateTime; }
+        void SetLastUpdateTime(uint32 updateTime)
+        {
+            m_lastUpdateTime = updateTime;
+            // moving average over roughly the last 8 updates, used as cost estimate by MapUpdater
+            m_averageUpdateTime = uint32((uint64(m_averageUpdateTime) * 7 + updateTime) / 8);
+        }
+
+        // threat work of the current or last Update() call, reset by MapUpdater
+        ThreatUpdateCounters& GetThreatUpdateCounters() { return m_threatUpdateCounters; }
+
         void MessageBroadcast(Player const*, WorldPacket const&, bool to_self);
         void MessageBroadcast(WorldObject const*, WorldPacket const&);
         void MessageDistBroadcast(Player const*, WorldPacket const&, float dist, bool to_self, bool own_team_only = false);
         void MessageDistBroadcast(WorldObject const*, WorldPacket const&, float dist);
 
+        // party member stats of a player on another map, sent by the next Update() of this map to
+        // the receiver if it is still here and doesn't see the member. Callable from any map thread.
+        void AddOutOfRangeMemberStats(ObjectGuid receiver, ObjectGuid member, WorldPacket const& data);
+
         float GetVisibilityDistance() const { return m_VisibleDistance; }
         // function for setting up visibility distance for maps on per-type/per-Id basis
         virtual void InitVisibilityDistance();
@@ -202,10 +223,6 @@ class Map : public GridRefManager<NGridType>
 
         void UpdateObjectVisibility(WorldObject* obj, Cell cell, CellPair cellpair);
 
-        void resetMarkedCells() { marked_cells.reset(); }
-        bool isCellMarked(uint32 pCellId) const { return marked_cells.test(pCellId); }
-        void markCell(uint32 pCellId) { marked_cells.set(pCellId); }
-
         bool HavePlayers() const { return !m_mapRefManager.isEmpty(); }
         uint32 GetPlayersCountExceptGMs() const;
         bool ActiveObjectsNearGrid(uint32 x, uint32 y) const;
@@ -249,14 +266,22 @@ class Map : public GridRefManager<NGridType>
 
         void AddUpdateObject(Object* obj)
         {
+            CellUpdateGuard guard = LockCellUpdate();
             i_objectsToClientUpdate.insert(obj);
         }
 
         void RemoveUpdateObject(Object* obj)
         {
+            CellUpdateGuard guard = LockCellUpdate();
             i_objectsToClientUpdate.erase(obj);
         }
 
+        // Parallel cell update (continents with MapUpdate.ContinentCellThreads)
+        // Cells are grouped in strips of whole grid columns. Worker threads only update the creatures
+        // whose update can't touch other objects (see Creature::IsLocalUpdate), even and odd strips
+        // in two phases, everything else is updated serially afterwards.
+        bool IsUpdatingCellsInParallel() const { return m_parallelCellUpdate; }
+
         // DynObjects currently
         uint32 GenerateLocalLowGuid(HighGuid guidhigh);
 
@@ -337,14 +362,43 @@ class Map : public GridRefManager<NGridType>
         void ScriptsProcess();
 
         void SendObjectUpdates();
+        typedef std::pair<Object const*, SharedValuesUpdateBlock const*> ObjectUpdate;     // changed object and its shared block, if any
+        typedef std::vector<ObjectUpdate> ObjectUpdateList;
+        typedef std::pair<Player*, ObjectUpdateList const*> ObjectUpdateReceiver;
+        typedef std::vector<ObjectUpdateReceiver> ObjectUpdateReceiverList;
+
+        // build, compress and send the value updates for players [begin, end) of a SendObjectUpdates pass, may run on worker threads
+        static void SendObjectUpdatesToPlayers(ObjectUpdateReceiverList const& updates, size_t begin, size_t end);
         std::set<Object*> i_objectsToClientUpdate;
 
+        typedef std::unique_lock<std::recursive_mutex> CellUpdateGuard;
+        // serializes access to map wide containers while cells are updated by several threads
+        CellUpdateGuard LockCellUpdate() const
+        {
+            return m_parallelCellUpdate ? CellUpdateGuard(m_cellUpdateLock) : CellUpdateGuard();
+        }
+
+        // Active cells: cells around players and active objects which get updated every tick.
+        // Each of these objects holds a reference on all cells in visibility range of the cell it stands in.
+        void AddActiveCellSource(WorldObject const* obj);
+        void RemoveActiveCellSource(WorldObject const* obj);
+        void MoveActiveCellSource(WorldObject const* obj, CellPair const& center);
+        void ModifyActiveCellRefs(CellPair const& center, CellPair const* skipCenter, int32 diff);
+        void RebuildActiveCells();
+
+        uint32 GetCellUpdateStrip(uint32 gridX) const { return gridX / m_cellUpdateStripWidth; }
+        void UpdateCells(std::vector<uint32> const& cells, uint32 diff);
+        void UpdateCellsInParallel(std::vector<uint32> const& cells, uint32 diff);
+
     protected:
         MapEntry const* i_mapEntry;
         uint8 i_spawnMode;
         uint32 i_id;
         uint32 i_InstanceId;
         uint32 m_unloadTimer;
+        uint32 m_lastUpdateTime;
+        uint32 m_averageUpdateTime;
+        ThreatUpdateCounters m_threatUpdateCounters;
         float m_VisibleDistance;
         MapPersistentState* m_persistentState;
 
@@ -353,7 +407,6 @@ class Map : public GridRefManager<NGridType>
 
         typedef std::set<WorldObject*> ActiveNonPlayers;
         ActiveNonPlayers m_activeNonPlayers;
-        ActiveNonPlayers::iterator m_activeNonPlayersIter;
         MapStoredObjectTypesContainer m_objectsStore;
 
     private:
@@ -365,7 +418,11 @@ class Map : public GridRefManager<NGridType>
         TerrainInfo* const m_TerrainData;
         bool m_bLoadedGrids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
 
-        std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
+        typedef std::unordered_map<uint32, uint32> ActiveCellRefs;                  // cell id -> number of objects in range
+        typedef std::unordered_map<WorldObject const*, CellPair> ActiveCellSources; // object -> cell it was counted from
+        ActiveCellRefs m_activeCells;
+        ActiveCellSources m_activeCellSources;
+        uint32 m_activeCellRadius;                          // in cells, from visibility distance
 
         std::set<WorldObject*> i_objectsToRemove;
 
@@ -396,6 +453,24 @@ class Map : public GridRefManager<NGridType>
 
         // WeatherSystem
         WeatherSystem* m_weatherSystem;
+
+        // Parallel cell update
+        bool m_parallelCellUpdate;
+        uint32 m_cellUpdateStripWidth;                      // in grids
+        mutable std::recursive_mutex m_cellUpdateLock;
+
+        // Party member stats queued by other maps
+        struct OutOfRangeMemberStats
+        {
+            ObjectGuid receiver;
+            ObjectGuid member;
+            WorldPacket data;
+        };
+
+        void SendOutOfRangeMemberStats();
+
+        std::mutex m_memberStatsLock;
+        std::vector<OutOfRangeMemberStats> m_memberStats;
 };
 
 class WorldMap : public Map
@@ -39,6 +39,8 @@ MapManager::MapManager()
 
 MapManager::~MapManager()
 {
+    m_updater.Deactivate();
+
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         delete iter->second;
 
@@ -52,6 +54,24 @@ void
 MapManager::Initialize()
 {
     InitStateMachine();
+
+    if (uint32 numThreads = sWorld.getConfig(CONFIG_UINT32_MAP_UPDATE_THREADS))
+    {
+        m_updater.Activate(numThreads);
+        sLog.outString("Map updates will use %u worker threads", numThreads);
+    }
+
+    if (uint32 numThreads = sWorld.getConfig(CONFIG_UINT32_MAP_UPDATE_CONTINENT_THREADS))
+    {
+        m_cellUpdatePool.reset(new MaNGOS::ThreadPool(numThreads));
+        sLog.outString("Continent cells will be updated by %u worker threads", numThreads);
+    }
+
+    if (uint32 numThreads = sWorld.getConfig(CONFIG_UINT32_MAP_UPDATE_OBJECT_THREADS))
+    {
+        m_objectUpdatePool.reset(new MaNGOS::ThreadPool(numThreads));
+        sLog.outString("Object update packets will be built by %u worker threads", numThreads);
+    }
 }
 
 void MapManager::InitStateMachine()
@@ -171,8 +191,18 @@ void MapManager::Update(uint32 diff)
     if (!i_timer.Passed())
         return;
 
-    for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
-        iter->second->Update((uint32)i_timer.GetCurrent());
+    std::vector<Map*> maps;
+    {
+        // maps can be created from maps already updated in a worker thread (instance entered)
+        Guard _guard(*this);
+
+        maps.reserve(i_maps.size());
+        for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
+            maps.push_back(iter->second);
+    }
+
+    m_updater.ScheduleUpdates(maps, (uint32)i_timer.GetCurrent());
+    m_updater.Wait();
 
     for (TransportSet::iterator iter = m_Transports.begin(); iter != m_Transports.end(); ++iter)
     {
@@ -225,6 +255,10 @@ bool MapManager::IsValidMAP(uint32 mapid)
 
 void MapManager::UnloadAll()
 {
+    m_updater.Deactivate();
+    m_cellUpdatePool.reset();
+    m_objectUpdatePool.reset();
+
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         iter->second->UnloadAll(true);
 
@@ -261,6 +295,23 @@ uint32 MapManager::GetNumPlayersInInstances()
     return ret;
 }
 
+void MapManager::GetLongestMapUpdates(std::vector<Map*>& maps, uint32 count) const
+{
+    Guard guard(*this);
+
+    maps.clear();
+    maps.reserve(i_maps.size());
+    for (MapMapType::const_iterator itr = i_maps.begin(); itr != i_maps.end(); ++itr)
+        maps.push_back(itr->second);
+
+    count = std::min(count, uint32(maps.size()));
+    std::partial_sort(maps.begin(), maps.begin() + count, maps.end(), [](Map const* a, Map const* b)
+    {
+        return a->GetAverageUpdateTime() > b->GetAverageUpdateTime();
+    });
+    maps.resize(count);
+}
+
 ///// returns a new or existing Instance
 ///// in case of battlegrounds it will only return an existing map, those maps are created by bg-system
 Map* MapManager::CreateInstance(uint32 id, Player* player)
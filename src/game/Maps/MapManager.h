@@ -23,7 +23,9 @@
 #include "Platform/Define.h"
 #include "Policies/Singleton.h"
 #include "Maps/Map.h"
+#include "Maps/MapUpdater.h"
 #include "Grids/GridStates.h"
+#include "Threading.h"
 
 class Transport;
 class BattleGround;
@@ -142,6 +144,13 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         /* statistics */
         uint32 GetNumInstances();
         uint32 GetNumPlayersInInstances();
+        uint32 GetNumMapUpdateThreads() const { return m_updater.GetThreadCount(); }
+        // workers for the parallel cell update of continents, nullptr if disabled
+        MaNGOS::ThreadPool* GetCellUpdatePool() const { return m_cellUpdatePool.get(); }
+        // workers building and compressing the object update packets of maps, nullptr if disabled
+        MaNGOS::ThreadPool* GetObjectUpdatePool() const { return m_objectUpdatePool.get(); }
+        // maps with the highest average update time, most expensive first
+        void GetLongestMapUpdates(std::vector<Map*>& maps, uint32 count) const;
 
         // get list of all maps
         const MapMapType& Maps() const { return i_maps; }
@@ -173,6 +182,9 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         uint32 i_gridCleanUpDelay;
         MapMapType i_maps;
         IntervalTimer i_timer;
+        MapUpdater m_updater;
+        std::unique_ptr<MaNGOS::ThreadPool> m_cellUpdatePool;
+        std::unique_ptr<MaNGOS::ThreadPool> m_objectUpdatePool;
 };
 
 template<typename Do>
@@ -0,0 +1,183 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Maps/MapUpdater.h"
+#include "Maps/Map.h"
+#include "World/World.h"
+#include "Log.h"
+
+#include <chrono>
+
+void MapUpdater::Activate(uint32 numThreads)
+{
+    Deactivate();
+
+    m_cancel = false;
+    m_queues.resize(numThreads);
+    m_workerThreads.reserve(numThreads);
+    for (uint32 i = 0; i < numThreads; ++i)
+        m_workerThreads.emplace_back(&MapUpdater::WorkerThread, this, i);
+}
+
+void MapUpdater::Deactivate()
+{
+    if (m_workerThreads.empty())
+        return;
+
+    Wait();
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_cancel = true;
+    }
+    m_requestCondition.notify_all();
+
+    for (std::vector<std::thread>::iterator itr = m_workerThreads.begin(); itr != m_workerThreads.end(); ++itr)
+        itr->join();
+
+    m_workerThreads.clear();
+    m_queues.clear();
+}
+
+void MapUpdater::ScheduleUpdates(std::vector<Map*>& maps, uint32 diff)
+{
+    // longest processing time first: expensive maps must start as early as possible
+    std::stable_sort(maps.begin(), maps.end(), [](Map const* a, Map const* b)
+    {
+        return a->GetAverageUpdateTime() > b->GetAverageUpdateTime();
+    });
+
+    if (m_workerThreads.empty())
+    {
+        for (std::vector<Map*>::const_iterator itr = maps.begin(); itr != maps.end(); ++itr)
+            UpdateMap(**itr, diff);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        for (std::vector<WorkerQueue>::iterator itr = m_queues.begin(); itr != m_queues.end(); ++itr)
+            itr->estimatedLoad = 0;
+
+        for (std::vector<Map*>::const_iterator itr = maps.begin(); itr != maps.end(); ++itr)
+        {
+            std::vector<WorkerQueue>::iterator queue = std::min_element(m_queues.begin(), m_queues.end(), [](WorkerQueue const& a, WorkerQueue const& b)
+            {
+                return a.estimatedLoad < b.estimatedLoad;
+            });
+
+            // count idle maps as 1us so they are still spread over the workers
+            uint32 cost = std::max((*itr)->GetAverageUpdateTime(), uint32(1));
+            queue->requests.push_back(MapUpdateRequest(**itr, diff, cost));
+            queue->estimatedLoad += cost;
+        }
+
+        m_pendingRequests += maps.size();
+        m_queuedRequests += maps.size();
+    }
+    m_requestCondition.notify_all();
+}
+
+void MapUpdater::Wait()
+{
+    std::unique_lock<std::mutex> guard(m_lock);
+    m_finishedCondition.wait(guard, [this] { return m_pendingRequests == 0; });
+}
+
+bool MapUpdater::PopRequest(uint32 index, MapUpdateRequest& request)
+{
+    // own queue first, from the expensive end
+    WorkerQueue& own = m_queues[index];
+    if (!own.requests.empty())
+    {
+        request = own.requests.front();
+        own.requests.pop_front();
+        own.estimatedLoad -= request.cost;
+        return true;
+    }
+
+    // steal the cheapest map of the other worker with the highest estimated cost still queued
+    WorkerQueue* victim = nullptr;
+    for (uint32 i = 1; i < m_queues.size(); ++i)
+    {
+        WorkerQueue& other = m_queues[(index + i) % m_queues.size()];
+        if (!other.requests.empty() && (!victim || other.estimatedLoad > victim->estimatedLoad))
+            victim = &other;
+    }
+
+    if (!victim)
+        return false;
+
+    request = victim->requests.back();
+    victim->requests.pop_back();
+    victim->estimatedLoad -= request.cost;
+    return true;
+}
+
+void MapUpdater::WorkerThread(uint32 index)
+{
+    for (;;)
+    {
+        MapUpdateRequest request;
+        {
+            std::unique_lock<std::mutex> guard(m_lock);
+            m_requestCondition.wait(guard, [this] { return m_cancel || m_queuedRequests != 0; });
+
+            // only fails with empty queues on shutdown
+            if (!PopRequest(index, request))
+                return;
+
+            --m_queuedRequests;
+        }
+
+        UpdateMap(*request.map, request.diff);
+
+        bool finished;
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            finished = --m_pendingRequests == 0;
+        }
+        if (finished)
+            m_finishedCondition.notify_all();
+    }
+}
+
+void MapUpdater::UpdateMap(Map& map, uint32 diff)
+{
+    ThreatUpdateCounters& threatCounters = map.GetThreatUpdateCounters();
+    threatCounters.Reset();
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    map.Update(diff);
+
+    uint32 updateTime = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count());
+    map.SetLastUpdateTime(updateTime);
+
+    uint32 longTick = sWorld.getConfig(CONFIG_UINT32_MAP_UPDATE_LONG_TICK_LOG);
+    if (longTick && updateTime >= longTick * IN_MILLISECONDS)
+    {
+        sLog.outString("MapUpdater: map %u (%s) instance %u took %u ms to update (%u ms average, %u players)",
+                       map.GetId(), map.GetMapName(), map.GetInstanceId(), updateTime / IN_MILLISECONDS,
+                       map.GetAverageUpdateTime() / IN_MILLISECONDS, map.GetPlayers().getSize());
+        sLog.outString("MapUpdater: threat work: %u threat changes, %u list sorts moving %u references, %u victim selections",
+                       threatCounters.threatChanges.load(), threatCounters.listSorts.load(),
+                       threatCounters.listMoves.load(), threatCounters.victimSelections.load());
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MAPUPDATER_H
+#define MANGOS_MAPUPDATER_H
+
+#include "Common.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+
+class Map;
+
+/**
+ * Runs Map::Update for a set of maps on a pool of worker threads.
+ *
+ * The world thread queues all maps with ScheduleUpdates() and then blocks in
+ * Wait() until the whole pass is finished, so everything done by MapManager
+ * after the pass (unloading, transports, remove lists) still runs single threaded.
+ *
+ * Maps are ordered by their average update cost, most expensive first, and dealt to
+ * the worker with the smallest estimated load. A worker which runs out of maps steals
+ * the cheapest remaining map from the queue with the highest estimated cost left, so the
+ * pass is bounded by the single most expensive map instead of by a bad initial distribution.
+ * Without worker threads ScheduleUpdates() updates the maps directly.
+ */
+class MapUpdater
+{
+    public:
+        MapUpdater() : m_pendingRequests(0), m_queuedRequests(0), m_cancel(false) {}
+        ~MapUpdater() { Deactivate(); }
+
+        void Activate(uint32 numThreads);
+        void Deactivate();
+        bool IsActive() const { return !m_workerThreads.empty(); }
+
+        void ScheduleUpdates(std::vector<Map*>& maps, uint32 diff);
+        void Wait();
+
+        uint32 GetThreadCount() const { return m_workerThreads.size(); }
+
+    private:
+        struct MapUpdateRequest
+        {
+            MapUpdateRequest() : map(nullptr), diff(0), cost(0) {}
+            MapUpdateRequest(Map& map, uint32 diff, uint32 cost) : map(&map), diff(diff), cost(cost) {}
+
+            Map* map;
+            uint32 diff;
+            uint32 cost;                                    // estimated update cost, taken from the average update time
+        };
+
+        struct WorkerQueue
+        {
+            WorkerQueue() : estimatedLoad(0) {}
+
+            std::deque<MapUpdateRequest> requests;
+            uint64 estimatedLoad;                           // sum of the estimated costs still queued for this worker
+        };
+
+        static void UpdateMap(Map& map, uint32 diff);
+
+        void WorkerThread(uint32 index);
+        bool PopRequest(uint32 index, MapUpdateRequest& request);
+
+        std::vector<std::thread> m_workerThreads;
+        std::vector<WorkerQueue> m_queues;                  // one per worker thread, guarded by m_lock
+
+        std::mutex m_lock;
+        std::condition_variable m_requestCondition;         // signaled when requests are queued or on shutdown
+        std::condition_variable m_finishedCondition;        // signaled when the last pending request is done
+        uint32 m_pendingRequests;                           // queued or currently updated maps
+        uint32 m_queuedRequests;                            // maps not yet picked up by any worker
+        bool m_cancel;
+};
+
+#endif
@@ -286,51 +286,92 @@ struct LocalData
     uint32 checkedDbcLocaleBuilds;
 };
 
+// check once per locale if its DBC subdir has DBCs for the main build
+static bool IsDbcLocaleAvailable(LocalData& localeData, uint8 i, StoreProblemList& errlist, const std::string& dbc_path, const std::string& filename)
+{
+    if (!(localeData.availableDbcLocales & (1 << i)))
+        return false;
+
+    LocaleNameStr const* localStr = &fullLocaleNameList[i];
+
+    std::string dbc_dir_loc = dbc_path + localStr->name + "/";
+
+    if (!(localeData.checkedDbcLocaleBuilds & (1 << i)))
+    {
+        localeData.checkedDbcLocaleBuilds |= (1 << i);  // mark as checked for speedup next checks
+
+        uint32 build_loc = ReadDBCBuild(dbc_dir_loc, localStr);
+        if (localeData.main_build != build_loc)
+        {
+            localeData.availableDbcLocales &= ~(1 << i); // mark as not available for speedup next checks
+
+            // exist but wrong build
+            if (build_loc)
+            {
+                std::string dbc_filename_loc = dbc_path + localStr->name + "/" + filename;
+                char buf[200];
+                snprintf(buf, 200, " (exist, but DBC locale subdir %s have DBCs for build %u instead expected build %u, it and other DBC from subdir skipped)", localStr->name, build_loc, localeData.main_build);
+                errlist.push_back(dbc_filename_loc + buf);
+            }
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
 template<class T>
 inline void LoadDBC(LocalData& localeData, BarGoLink& bar, StoreProblemList& errlist, DBCStorage<T>& storage, const std::string& dbc_path, const std::string& filename)
 {
     // compatibility format and C++ structure sizes
     MANGOS_ASSERT(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()) == sizeof(T) || LoadDBC_assert_print(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()), sizeof(T), filename));
 
-    std::string dbc_filename = dbc_path + filename;
-    if (storage.Load(dbc_filename.c_str()))
+    if (DBCImage::IsEnabled())
     {
-        bar.step();
+        // the image must be built from the same main and locale files the store would be loaded from
+        DBCImage::SourceList sources;
+        sources.push_back(DBCImage::Source(dbc_path, filename));
         for (uint8 i = 0; fullLocaleNameList[i].name; ++i)
         {
-            if (!(localeData.availableDbcLocales & (1 << i)))
+            if (!IsDbcLocaleAvailable(localeData, i, errlist, dbc_path, filename))
                 continue;
 
-            LocaleNameStr const* localStr = &fullLocaleNameList[i];
-
-            std::string dbc_dir_loc = dbc_path + localStr->name + "/";
-
-            if (!(localeData.checkedDbcLocaleBuilds & (1 << i)))
-            {
-                localeData.checkedDbcLocaleBuilds |= (1 << i); // mark as checked for speedup next checks
+            DBCImage::Source source(dbc_path, std::string(fullLocaleNameList[i].name) + "/" + filename);
+            if (source.Exists())
+                sources.push_back(source);
+            else
+                localeData.availableDbcLocales &= ~(1 << i); // mark as not available for speedup next checks
+        }
 
-                uint32 build_loc = ReadDBCBuild(dbc_dir_loc, localStr);
-                if (localeData.main_build != build_loc)
-                {
-                    localeData.availableDbcLocales &= ~(1 << i); // mark as not available for speedup next checks
+        if (storage.LoadImage(filename.c_str(), sources))
+        {
+            bar.step();
+            return;
+        }
+    }
 
-                    // exist but wrong build
-                    if (build_loc)
-                    {
-                        std::string dbc_filename_loc = dbc_path + localStr->name + "/" + filename;
-                        char buf[200];
-                        snprintf(buf, 200, " (exist, but DBC locale subdir %s have DBCs for build %u instead expected build %u, it and other DBC from subdir skipped)", localStr->name, build_loc, localeData.main_build);
-                        errlist.push_back(dbc_filename_loc + buf);
-                    }
+    std::string dbc_filename = dbc_path + filename;
+    if (storage.Load(dbc_filename.c_str()))
+    {
+        bar.step();
 
-                    continue;
-                }
-            }
+        DBCImage::SourceList sources;
+        sources.push_back(DBCImage::Source(dbc_path, filename));
+        for (uint8 i = 0; fullLocaleNameList[i].name; ++i)
+        {
+            if (!IsDbcLocaleAvailable(localeData, i, errlist, dbc_path, filename))
+                continue;
 
-            std::string dbc_filename_loc = dbc_path + localStr->name + "/" + filename;
-            if (!storage.LoadStringsFrom(dbc_filename_loc.c_str()))
+            std::string dbc_filename_loc = dbc_path + fullLocaleNameList[i].name + "/" + filename;
+            if (storage.LoadStringsFrom(dbc_filename_loc.c_str()))
+                sources.push_back(DBCImage::Source(dbc_path, std::string(fullLocaleNameList[i].name) + "/" + filename));
+            else
                 localeData.availableDbcLocales &= ~(1 << i);// mark as not available for speedup next checks
         }
+
+        if (DBCImage::IsEnabled())
+            storage.SaveImage(filename.c_str(), sources);
     }
     else
     {
@@ -94,7 +94,7 @@ WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, uint8
     m_muteTime(mute_time), m_GUIDLow(0), _player(nullptr), m_Socket(sock ? sock->shared<WorldSocket>() : nullptr), _security(sec), _accountId(id), m_expansion(expansion),
     _logoutTime(0), m_inQueue(false), m_playerLoading(false), m_playerLogout(false), m_playerRecentlyLogout(false), m_playerSave(false),
     m_sessionDbcLocale(sWorld.GetAvailableDbcLocale(locale)), m_sessionDbLocaleIndex(sObjectMgr.GetIndexForLocale(locale)),
-    m_latency(0), m_clientTimeDelay(0), m_tutorialState(TUTORIALDATA_UNCHANGED)
+    m_latency(0), m_clientTimeDelay(0), m_tutorialState(TUTORIALDATA_UNCHANGED), m_recvQueueDropped(0)
 {}
 
 /// WorldSession destructor
@@ -128,6 +128,20 @@ char const* WorldSession::GetPlayerName() const
 
 /// Send a packet to the client
 void WorldSession::SendPacket(WorldPacket const& packet) const
+{
+    if (PrepareSendPacket(packet))
+        m_Socket->SendPacket(packet);
+}
+
+/// Send a packet shared with other sessions to the client, its content is not copied
+void WorldSession::SendPacket(SharedWorldPacket const& packet) const
+{
+    if (PrepareSendPacket(*packet))
+        m_Socket->SendPacket(packet);
+}
+
+/// Common part of the SendPacket variants, returns false if the packet is not sent to a socket
+bool WorldSession::PrepareSendPacket(WorldPacket const& packet) const
 {
 #ifdef BUILD_PLAYERBOT
     // Send packet to bot AI
@@ -140,11 +154,11 @@ void WorldSession::SendPacket(WorldPacket const& packet) const
     }
     
     if (!m_Socket)
-        return;
+        return false;
 #endif
 
     if (m_Socket->IsClosed())
-        return;
+        return false;
 
 #ifdef MANGOS_DEBUG
 
@@ -182,14 +196,40 @@ void WorldSession::SendPacket(WorldPacket const& packet) const
 
 #endif                                                  // !MANGOS_DEBUG
 
-    m_Socket->SendPacket(packet);
+    return true;
 }
 
-/// Add an incoming packet to the queue
-void WorldSession::QueuePacket(std::unique_ptr<WorldPacket> new_packet)
+void PacketBroadcaster::SendTo(WorldSession& session)
 {
-    std::lock_guard<std::mutex> guard(m_recvQueueLock);
-    m_recvQueue.push_back(std::move(new_packet));
+    // small packets are copied by the socket anyway
+    if (m_packet.size() < WorldSocket::SharedPacketMinSize)
+    {
+        session.SendPacket(m_packet);
+        return;
+    }
+
+    if (!m_shared)
+        m_shared = std::make_shared<WorldPacket>(m_packet);
+
+    session.SendPacket(m_shared);
+}
+
+/// Add an incoming packet to the queue, returns false if the connection should be closed
+bool WorldSession::QueuePacket(std::unique_ptr<WorldPacket> new_packet)
+{
+    // Playerbot mod: bots don't have sockets and are never limited
+    if (!m_Socket)
+    {
+        m_recvQueue.Enqueue(std::move(new_packet));
+        return true;
+    }
+
+    if (m_recvQueue.TryEnqueue(std::move(new_packet), sWorld.getConfig(CONFIG_UINT32_SESSION_RECV_QUEUE_LIMIT)))
+        return true;
+
+    // queue full: the client sends faster than the session is updated
+    ++m_recvQueueDropped;
+    return sWorld.getConfig(CONFIG_UINT32_SESSION_RECV_QUEUE_OVERFLOW) != RECV_QUEUE_OVERFLOW_DISCONNECT;
 }
 
 /// Logging helper for unexpected opcodes
@@ -213,14 +253,19 @@ void WorldSession::LogUnprocessedTail(WorldPacket &packet) const
 /// Update the WorldSession (triggered by World update)
 bool WorldSession::Update(PacketFilter& updater)
 {
-    std::lock_guard<std::mutex> guard(m_recvQueueLock);
+    if (uint32 dropped = m_recvQueueDropped.exchange(0))
+        sLog.outError("WorldSession::Update: receive queue of account %u (address %s) overflowed, %u packets %s",
+                      GetAccountId(), GetRemoteAddress().c_str(), dropped,
+                      sWorld.getConfig(CONFIG_UINT32_SESSION_RECV_QUEUE_OVERFLOW) == RECV_QUEUE_OVERFLOW_DISCONNECT ? "refused, disconnecting" : "dropped");
 
     ///- Retrieve packets from the receive queue and call the appropriate handlers
     /// not process packets if socket already closed
-    while (m_Socket && !m_Socket->IsClosed() && !m_recvQueue.empty())
+    /// packets arriving while processing wait for the next update
+    /// a packet the updater does not accept stays queued, with all after it, for the other update pass
+    std::unique_ptr<WorldPacket> packet;
+    auto accepted = [&updater](std::unique_ptr<WorldPacket> const& next) { return updater.Process(*next); };
+    for (size_t count = m_recvQueue.Size(); count && m_Socket && !m_Socket->IsClosed() && m_recvQueue.DequeueIf(packet, accepted); --count)
     {
-        auto const packet = std::move(m_recvQueue.front());
-        m_recvQueue.pop_front();
 
         /*#if 1
         sLog.outError( "MOEP: %s (0x%.4X)",
@@ -324,7 +369,8 @@ bool WorldSession::Update(PacketFilter& updater)
     // The PlayerbotAI class adds to the packet queue to simulate a real player
     // since Playerbots are known to the World obj only by its master's WorldSession object
     // we need to process all master's bot's packets.
-    if (GetPlayer() && GetPlayer()->GetPlayerbotMgr())
+    // Their handlers are not filtered, so only in World::UpdateSessions().
+    if (updater.ProcessLogout() && GetPlayer() && GetPlayer()->GetPlayerbotMgr())
     {
         for (PlayerBotMap::const_iterator itr = GetPlayer()->GetPlayerbotMgr()->GetPlayerBotsBegin();
                 itr != GetPlayer()->GetPlayerbotMgr()->GetPlayerBotsEnd(); ++itr)
@@ -332,15 +378,12 @@ bool WorldSession::Update(PacketFilter& updater)
             Player* const botPlayer = itr->second;
             WorldSession* const pBotWorldSession = botPlayer->GetSession();
 
-            while(!pBotWorldSession->m_recvQueue.empty())
+            std::unique_ptr<WorldPacket> botpacket;
+            while (pBotWorldSession->m_recvQueue.Dequeue(botpacket))
             {
-                auto const botpacket = std::move(pBotWorldSession->m_recvQueue.front());
-                pBotWorldSession->m_recvQueue.pop_front();
-
                 OpcodeHandler const& opHandle = opcodeTable[botpacket->GetOpcode()];
                 pBotWorldSession->ExecuteOpcode(opHandle, *botpacket);
             }
-            pBotWorldSession->m_recvQueue.clear();
         }
     }
 #endif
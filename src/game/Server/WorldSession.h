@@ -29,9 +29,9 @@
 #include "AuctionHouse/AuctionHouseMgr.h"
 #include "Entities/Item.h"
 #include "Server/WorldSocket.h"
+#include "MPSCQueue.h"
 
-#include <deque>
-#include <mutex>
+#include <atomic>
 #include <memory>
 
 struct ItemPrototype;
@@ -190,6 +190,13 @@ enum TutorialDataState
     TUTORIALDATA_NEW       = 2
 };
 
+// what happens to packets received while the session receive queue is full
+enum RecvQueueOverflowPolicy
+{
+    RECV_QUEUE_OVERFLOW_DROP       = 0,                     // drop the packet, keep the connection
+    RECV_QUEUE_OVERFLOW_DISCONNECT = 1                      // close the connection
+};
+
 // class to deal with packet processing
 // allows to determine if next packet is safe to be processed
 class PacketFilter
@@ -228,6 +235,20 @@ class WorldSessionFilter : public PacketFilter
         virtual bool Process(WorldPacket const& packet) const override;
 };
 
+// sends one packet to many sessions, the content is copied once into a shared
+// packet and only the header is written per receiver
+class PacketBroadcaster
+{
+    public:
+        explicit PacketBroadcaster(WorldPacket const& packet) : m_packet(packet) {}
+
+        void SendTo(WorldSession& session);
+
+    private:
+        WorldPacket const& m_packet;
+        SharedWorldPacket m_shared;                         // created for the first receiver
+};
+
 /// Player session in the World
 class WorldSession
 {
@@ -247,6 +268,7 @@ class WorldSession
         void SendAddonsInfo();
 
         void SendPacket(WorldPacket const& packet) const;
+        void SendPacket(SharedWorldPacket const& packet) const;
         void SendNotification(const char* format, ...) const ATTR_PRINTF(2, 3);
         void SendNotification(int32 string_id, ...) const;
         void SendPetNameInvalid(uint32 error, const std::string& name, DeclinedName* declinedName) const;
@@ -296,7 +318,7 @@ class WorldSession
         void LogoutPlayer(bool Save);
         void KickPlayer();
 
-        void QueuePacket(std::unique_ptr<WorldPacket> new_packet);
+        bool QueuePacket(std::unique_ptr<WorldPacket> new_packet);
 
         bool Update(PacketFilter& updater);
 
@@ -884,6 +906,7 @@ class WorldSession
         void HandleMoverRelocation(MovementInfo& movementInfo);
 
         void ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket & packet);
+        bool PrepareSendPacket(WorldPacket const& packet) const;
 
         // logging helper
         void LogUnexpectedOpcode(WorldPacket const& packet, const char* reason) const;
@@ -912,8 +935,9 @@ class WorldSession
         TutorialDataState m_tutorialState;
         AddonsList m_addonsList;
 
-        std::mutex m_recvQueueLock;
-        std::deque<std::unique_ptr<WorldPacket>> m_recvQueue;
+        // filled by the network thread of the socket (and by playerbot AI), drained in Update
+        MaNGOS::MPSCQueue<std::unique_ptr<WorldPacket>> m_recvQueue;
+        std::atomic<uint32> m_recvQueueDropped;             // packets refused on overflow since the last Update
 };
 #endif
 /// @}
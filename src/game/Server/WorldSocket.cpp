@@ -86,31 +86,97 @@ WorldSocket::WorldSocket(boost::asio::io_service &service, std::function<void (S
       m_useExistingHeader(false), m_session(nullptr),m_seed(urand())
 {}
 
-void WorldSocket::SendPacket(const WorldPacket& pct, bool immediate)
+// packets the client should see without waiting for the coalescing window
+static bool IsLatencyCriticalOpcode(uint16 opcode)
+{
+    switch (opcode)
+    {
+        case SMSG_PONG:
+        case SMSG_MONSTER_MOVE:
+        case SMSG_MONSTER_MOVE_TRANSPORT:
+        case MSG_MOVE_START_FORWARD:
+        case MSG_MOVE_START_BACKWARD:
+        case MSG_MOVE_STOP:
+        case MSG_MOVE_JUMP:
+        case MSG_MOVE_TELEPORT_ACK:
+        case SMSG_ATTACKSTART:
+        case SMSG_ATTACKSTOP:
+        case SMSG_ATTACKERSTATEUPDATE:
+        case SMSG_SPELL_START:
+        case SMSG_SPELL_GO:
+        case SMSG_SPELL_FAILURE:
+        case SMSG_SPELLNONMELEEDAMAGELOG:
+        case SMSG_SPELLHEALLOG:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool WorldSocket::WriteHeader(const WorldPacket& pct)
 {
     if (IsClosed())
-        return;
+        return false;
 
     // Dump outgoing packet.
     sLog.outWorldPacketDump(GetRemoteEndpoint().c_str(), pct.GetOpcode(), pct.GetOpcodeName(), pct, false);
 
+    // the header is encrypted per connection, the content is the same for every receiver
     ServerPktHeader header(pct.size() + 2, pct.GetOpcode());
     m_crypt.EncryptSend((uint8*)header.header, header.getHeaderLength());
 
     Write((const char *)header.header, header.getHeaderLength());
+    return true;
+}
 
-    if (!!pct.size())
-        Write((const char *)pct.contents(), pct.size());
-
-    if (immediate)
+void WorldSocket::FlushAfterPacket(const WorldPacket& pct, bool immediate)
+{
+    if (immediate || (sWorld.getConfig(CONFIG_BOOL_NETWORK_FLUSH_CRITICAL) && IsLatencyCriticalOpcode(pct.GetOpcode())))
         ForceFlushOut();
 }
 
+void WorldSocket::SendPacket(const WorldPacket& pct, bool immediate)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_sendLock);
+
+        if (!WriteHeader(pct))
+            return;
+
+        if (!!pct.size())
+            Write((const char *)pct.contents(), pct.size());
+    }
+
+    FlushAfterPacket(pct, immediate);
+}
+
+void WorldSocket::SendPacket(const SharedWorldPacket& pct, bool immediate)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_sendLock);
+
+        if (!WriteHeader(*pct))
+            return;
+
+        // small contents are cheaper to copy next to the header than to send as a separate buffer
+        if (pct->size() >= SharedPacketMinSize)
+            Write(pct);
+        else if (!!pct->size())
+            Write((const char *)pct->contents(), pct->size());
+    }
+
+    FlushAfterPacket(*pct, immediate);
+}
+
 bool WorldSocket::Open()
 {
     if (!Socket::Open())
         return false;
 
+    // until the first ping tells the latency the full delay is used
+    SetBufferTimeout(sWorld.getConfig(CONFIG_UINT32_NETWORK_FLUSH_DELAY));
+    SetFlushThreshold(sWorld.getConfig(CONFIG_UINT32_NETWORK_FLUSH_SIZE));
+
     // Send startup packet.
     WorldPacket packet(SMSG_AUTH_CHALLENGE, 40);
     packet << uint32(1);                                    // 1...31
@@ -226,9 +292,7 @@ bool WorldSocket::ProcessIncomingData()
                     return false;
                 }
 
-                m_session->QueuePacket(std::move(pct));
-
-                return true;
+                return m_session->QueuePacket(std::move(pct));
             }
         }
     }
@@ -509,6 +573,16 @@ bool WorldSocket::HandlePing(WorldPacket &recvPacket)
         {
             m_session->SetLatency(latency);
             m_session->ResetClientTimeDelay();
+
+            // coalescing delay is only noticeable when small compared to the round trip; the latency is
+            // reported by the client, so keep the delay within the configured range whatever it sends
+            if (uint32 rttPercent = sWorld.getConfig(CONFIG_UINT32_NETWORK_FLUSH_DELAY_RTT_PERCENT))
+            {
+                uint32 maxDelay = sWorld.getConfig(CONFIG_UINT32_NETWORK_FLUSH_DELAY);
+                uint32 minDelay = std::min(sWorld.getConfig(CONFIG_UINT32_NETWORK_FLUSH_DELAY_MIN), maxDelay);
+                uint64 delay = uint64(latency) * rttPercent / 100;
+                SetBufferTimeout(uint32(std::max(std::min(delay, uint64(maxDelay)), uint64(minDelay))));
+            }
         }
         else
         {
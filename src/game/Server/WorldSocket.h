@@ -32,10 +32,14 @@
 
 #include <chrono>
 #include <functional>
+#include <memory>
 
 class WorldPacket;
 class WorldSession;
 
+/// Packet which is not modified anymore and can be queued on many sockets without copying its content
+typedef std::shared_ptr<WorldPacket const> SharedWorldPacket;
+
 /**
  * WorldSocket.
  *
@@ -44,14 +48,17 @@ class WorldSession;
  * Most methods return -1 on failure.
  * The class uses reference counting.
  *
- * For output the class uses one buffer (64K usually) and
- * a queue where it stores packet if there is no place on
- * the queue. The reason this is done, is because the server
+ * For output the class uses a queue of segments, small
+ * packets are copied together into one segment while large
+ * shared packets are queued by reference, and the queue is
+ * sent with one gathered write. The reason this is done, is because the server
  * does really a lot of small-size writes to it, and it doesn't
  * scale well to allocate memory for every. When something is
  * written to the output buffer the socket is not immediately
  * activated for output (again for the same reason), there
- * is 10ms celling (thats why there is Update() override method).
+ * is a celling of Network.FlushDelay, shortened by the
+ * client round trip time and skipped for latency critical
+ * opcodes or when Network.FlushSize bytes are buffered.
  * This concept is similar to TCP_CORK, but TCP_CORK
  * uses 200ms celling. As result overhead generated by
  * sending packets from "producer" threads is minimal,
@@ -104,6 +111,9 @@ class WorldSocket : public MaNGOS::Socket
         /// Class used for managing encryption of the headers
         AuthCrypt m_crypt;
 
+        /// Keeps header encryption and the writes of one packet together when several threads send
+        std::mutex m_sendLock;
+
         /// Session to which received packets are routed
         WorldSession *m_session;
 
@@ -120,11 +130,24 @@ class WorldSocket : public MaNGOS::Socket
         /// Called by ProcessIncoming() on CMSG_PING.
         bool HandlePing(WorldPacket &recvPacket);
 
+        /// Encrypt and queue the header of an outgoing packet, false if the socket is closed. Needs m_sendLock.
+        bool WriteHeader(const WorldPacket& pct);
+
+        /// Flush now if requested or if the opcode is latency critical.
+        void FlushAfterPacket(const WorldPacket& pct, bool immediate);
+
     public:
+        /// Shared packets smaller than this are copied into the socket buffer like normal packets. Movement packets
+        /// are larger and shared; a referenced content splits the copied buffer, adding two buffers to the gathered
+        /// write, which is worth less than copying a handful of bytes like an emote.
+        static const size_t SharedPacketMinSize = 32;
+
         WorldSocket(boost::asio::io_service &service, std::function<void (Socket *)> closeHandler);
 
         // send a packet \o/
         void SendPacket(const WorldPacket& pct, bool immediate = false);
+        // send a shared packet, larger contents are referenced by the socket instead of copied
+        void SendPacket(const SharedWorldPacket& pct, bool immediate = false);
 
         void FinalizeSession() { m_session = nullptr; }
 
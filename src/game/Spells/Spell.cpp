@@ -7954,7 +7954,7 @@ void Spell::ResetEffectDamageAndHeal()
 void Spell::ProcSpellAuraTriggers()
 {
     Unit::AuraList const& targetTriggers = m_caster->GetAurasByType(SPELL_AURA_ADD_TARGET_TRIGGER);
-    for (Unit::AuraList::const_iterator i = targetTriggers.begin(); i != targetTriggers.end(); ++i)
+    for (Unit::AuraList::Walker i(targetTriggers); !i.AtEnd(); ++i)
     {
         if (!(*i)->isAffectedOnSpell(m_spellInfo))
             continue;
@@ -877,6 +877,9 @@ void Aura::ApplyModifier(bool apply, bool Real)
         (*this.*AuraHandler [aura])(apply, Real);
     SetInUse(false);
     GetHolder()->SetInUse(false);
+
+    // handlers can make the aura periodic
+    GetTarget()->ChangeSpellAuraHoldersVersion();
 }
 
 bool Aura::isAffectedOnSpell(SpellEntry const* spell) const
@@ -1778,7 +1781,7 @@ void Aura::TriggerSpell()
                     {
                         // Summon an Exploding Orb for each player in combat with the caster
                         ThreatList const& threatList = target->getThreatManager().getThreatList();
-                        for (ThreatList::const_iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
+                        for (ThreatList::Walker itr(threatList); !itr.AtEnd(); ++itr)
                         {
                             if (Unit* expectedTarget = target->GetMap()->GetUnit((*itr)->getUnitGuid()))
                             {
@@ -4598,7 +4601,7 @@ void Aura::HandleModStealth(bool apply, bool Real)
             if (target->GetAurasByType(SPELL_AURA_MOD_STEALTH).size() <= 1)
             {
                 Unit::AuraList const& mDummyAuras = target->GetAurasByType(SPELL_AURA_DUMMY);
-                for (Unit::AuraList::const_iterator i = mDummyAuras.begin(); i != mDummyAuras.end(); ++i)
+                for (Unit::AuraList::Walker i(mDummyAuras); !i.AtEnd(); ++i)
                 {
                     // Master of Subtlety
                     if ((*i)->GetSpellProto()->SpellIconID == 2114)
@@ -4641,7 +4644,7 @@ void Aura::HandleModStealth(bool apply, bool Real)
 
             // apply delayed talent bonus remover at last stealth aura remove
             Unit::AuraList const& mDummyAuras = target->GetAurasByType(SPELL_AURA_DUMMY);
-            for (Unit::AuraList::const_iterator i = mDummyAuras.begin(); i != mDummyAuras.end(); ++i)
+            for (Unit::AuraList::Walker i(mDummyAuras); !i.AtEnd(); ++i)
             {
                 // Master of Subtlety
                 if ((*i)->GetSpellProto()->SpellIconID == 2114)
@@ -7209,7 +7212,7 @@ void Aura::HandleSchoolAbsorb(bool apply, bool Real)
                 (m_removeMode == AURA_REMOVE_BY_SHIELD_BREAK || m_removeMode == AURA_REMOVE_BY_DISPEL))
         {
             Unit::AuraList const& vDummyAuras = caster->GetAurasByType(SPELL_AURA_DUMMY);
-            for (Unit::AuraList::const_iterator itr = vDummyAuras.begin(); itr != vDummyAuras.end(); ++itr)
+            for (Unit::AuraList::Walker itr(vDummyAuras); !itr.AtEnd(); ++itr)
             {
                 SpellEntry const* vSpell = (*itr)->GetSpellProto();
 
@@ -10324,8 +10327,12 @@ void SpellAuraHolder::SetAuraMaxDuration(int32 duration)
     // possible overwrite persistent state
     if (!GetSpellProto()->HasAttribute(SPELL_ATTR_EX5_HIDE_DURATION) && duration > 0)
     {
-        if (!(IsPassive() && GetSpellProto()->DurationIndex == 0))
+        if (!(IsPassive() && GetSpellProto()->DurationIndex == 0) && IsPermanent())
+        {
             SetPermanent(false);
+            if (m_target)
+                m_target->ChangeSpellAuraHoldersVersion();
+        }
 
         SetAuraFlags(GetAuraFlags() | AFLAG_DURATION);
     }
@@ -1604,6 +1604,9 @@ class SpellMgr
             return nullptr;
         }
 
+        // changed at each (re)load of the spell proc events
+        uint32 GetSpellProcEventsVersion() const { return m_spellProcEventsVersion; }
+
         // Spell procs from item enchants
         float GetItemEnchantProcChance(uint32 spellid) const
         {
@@ -1845,6 +1848,7 @@ class SpellMgr
         SpellElixirMap     mSpellElixirs;
         SpellThreatMap     mSpellThreatMap;
         SpellProcEventMap  mSpellProcEventMap;
+        uint32             m_spellProcEventsVersion;
         SpellProcItemEnchantMap mSpellProcItemEnchantMap;
         SpellBonusMap      mSpellBonusMap;
         SkillLineAbilityMap mSkillLineAbilityMap;
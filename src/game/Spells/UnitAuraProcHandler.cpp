@@ -738,26 +738,26 @@ SpellAuraProcResult Unit::HandleDummyAuraProc(Unit* pVictim, uint32 damage, Aura
                 }
                 // Elemental Sieve
                 case 36035:
-                {
-                    Creature* pCaster = dynamic_cast<Creature*>(triggeredByAura->GetCaster());
-
-                    // aura only affect the spirit totem, since this is the one that need to be in range.
-                    // It is possible though, that player is the one who should actually have the aura
-                    // and check for presense of spirit totem, but then we can't script the dummy.
-                    if (!pCaster->IsPet())
-                        return SPELL_AURA_PROC_FAILED;
-
-                    // Summon the soul of the spirit and cast the visual
-                    uint32 uiSoulEntry = 0;
-                    switch (GetEntry())
-                    {
-                        case 21050: uiSoulEntry = 21073; break; // Earthen Soul
-                        case 21061: uiSoulEntry = 21097; break; // Fiery Soul
-                        case 21059: uiSoulEntry = 21109; break; // Watery Soul
-                        case 21060: uiSoulEntry = 21116; break; // Airy Soul
-                    }
-
-                    CastSpell(this, 36206, TRIGGERED_OLD_TRIGGERED);
+                {
+                    Creature* pCaster = dynamic_cast<Creature*>(triggeredByAura->GetCaster());
+
+                    // aura only affect the spirit totem, since this is the one that need to be in range.
+                    // It is possible though, that player is the one who should actually have the aura
+                    // and check for presense of spirit totem, but then we can't script the dummy.
+                    if (!pCaster->IsPet())
+                        return SPELL_AURA_PROC_FAILED;
+
+                    // Summon the soul of the spirit and cast the visual
+                    uint32 uiSoulEntry = 0;
+                    switch (GetEntry())
+                    {
+                        case 21050: uiSoulEntry = 21073; break; // Earthen Soul
+                        case 21061: uiSoulEntry = 21097; break; // Fiery Soul
+                        case 21059: uiSoulEntry = 21109; break; // Watery Soul
+                        case 21060: uiSoulEntry = 21116; break; // Airy Soul
+                    }
+
+                    CastSpell(this, 36206, TRIGGERED_OLD_TRIGGERED);
                     pCaster->SummonCreature(uiSoulEntry, GetPositionX(), GetPositionY(), GetPositionZ(), 0, TEMPSUMMON_TIMED_OOC_OR_CORPSE_DESPAWN, 10000);
                     break;
                 }
@@ -2595,7 +2595,7 @@ SpellAuraProcResult Unit::HandleDummyAuraProc(Unit* pVictim, uint32 damage, Aura
             {
                 // lookup Lightning Shield
                 AuraList const& vs = GetAurasByType(SPELL_AURA_PROC_TRIGGER_SPELL);
-                for (AuraList::const_iterator itr = vs.begin(); itr != vs.end(); ++itr)
+                for (AuraList::Walker itr(vs); !itr.AtEnd(); ++itr)
                 {
                     if ((*itr)->GetSpellProto()->SpellFamilyName == SPELLFAMILY_SHAMAN &&
                             ((*itr)->GetSpellProto()->SpellFamilyFlags & uint64(0x0000000000000400)))
@@ -21,6 +21,7 @@
 */
 
 #include "World/World.h"
+#include "World/WorldLoader.h"
 #include "Database/DatabaseEnv.h"
 #include "Config/Config.h"
 #include "Platform/Define.h"
@@ -497,6 +498,15 @@ void World::LoadConfigSettings(bool reload)
     if (reload)
         sMapMgr.SetMapUpdateInterval(getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE));
 
+    if (configNoReload(reload, CONFIG_UINT32_MAP_UPDATE_THREADS, "MapUpdate.Threads", 0))
+        setConfig(CONFIG_UINT32_MAP_UPDATE_THREADS, "MapUpdate.Threads", 0);
+    setConfig(CONFIG_UINT32_MAP_UPDATE_LONG_TICK_LOG, "MapUpdate.LongTickLog", 0);
+    setConfig(CONFIG_UINT32_STARTUP_LOAD_THREADS, "StartupLoad.Threads", 0);
+    if (configNoReload(reload, CONFIG_UINT32_MAP_UPDATE_CONTINENT_THREADS, "MapUpdate.ContinentCellThreads", 0))
+        setConfig(CONFIG_UINT32_MAP_UPDATE_CONTINENT_THREADS, "MapUpdate.ContinentCellThreads", 0);
+    if (configNoReload(reload, CONFIG_UINT32_MAP_UPDATE_OBJECT_THREADS, "MapUpdate.ObjectUpdateThreads", 0))
+        setConfig(CONFIG_UINT32_MAP_UPDATE_OBJECT_THREADS, "MapUpdate.ObjectUpdateThreads", 0);
+
     setConfig(CONFIG_UINT32_INTERVAL_CHANGEWEATHER, "ChangeWeatherInterval", 10 * MINUTE * IN_MILLISECONDS);
 
     if (configNoReload(reload, CONFIG_UINT32_PORT_WORLD, "WorldServerPort", DEFAULT_WORLDSERVER_PORT))
@@ -724,6 +734,13 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_OFFHAND_CHECK_AT_TALENTS_RESET, "OffhandCheckAtTalentsReset", false);
 
     setConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET, "Network.KickOnBadPacket", false);
+    setConfig(CONFIG_UINT32_SESSION_RECV_QUEUE_LIMIT, "Network.RecvQueueLimit", 1000);
+    setConfigMinMax(CONFIG_UINT32_SESSION_RECV_QUEUE_OVERFLOW, "Network.RecvQueueOverflow", RECV_QUEUE_OVERFLOW_DROP, RECV_QUEUE_OVERFLOW_DROP, RECV_QUEUE_OVERFLOW_DISCONNECT);
+    setConfigMinMax(CONFIG_UINT32_NETWORK_FLUSH_DELAY, "Network.FlushDelay", 50, 0, 1000);
+    setConfigMinMax(CONFIG_UINT32_NETWORK_FLUSH_DELAY_RTT_PERCENT, "Network.FlushDelayRttPercent", 10, 0, 100);
+    setConfigMinMax(CONFIG_UINT32_NETWORK_FLUSH_DELAY_MIN, "Network.FlushDelayMin", 5, 1, 1000);
+    setConfig(CONFIG_UINT32_NETWORK_FLUSH_SIZE, "Network.FlushSize", 8192);
+    setConfig(CONFIG_BOOL_NETWORK_FLUSH_CRITICAL, "Network.FlushCritical", true);
 
     setConfig(CONFIG_BOOL_PLAYER_COMMANDS, "PlayerCommands", true);
 
@@ -850,6 +867,13 @@ void World::LoadConfigSettings(bool reload)
         sLog.outString("Using DataDir %s", m_dataPath.c_str());
     }
 
+    ///- Read the directory for binary copies of the world tables, empty to always load them from the database
+    SQLStorageSnapshot::SetDirectory(sConfig.GetStringDefault("SnapshotDir", ""));
+
+    ///- Read the directory for memory images of the DBC stores, empty to always load the DBC files
+    if (!reload)
+        DBCImage::SetDirectory(sConfig.GetStringDefault("DBCImageDir", ""));
+
     setConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK, "vmap.enableIndoorCheck", true);
     bool enableLOS = sConfig.GetBoolDefault("vmap.enableLOS", false);
     bool enableHeight = sConfig.GetBoolDefault("vmap.enableHeight", false);
@@ -967,93 +991,39 @@ void World::SetInitialWorldSettings()
     sObjectMgr.SetHighestGuids();                           // must be after PackInstances() and PackGroupIds()
     sLog.outString();
 
-    sLog.outString("Loading Page Texts...");
-    sObjectMgr.LoadPageTexts();
-
-    sLog.outString("Loading Game Object Templates...");     // must be after LoadPageTexts
-    sObjectMgr.LoadGameobjectInfo();
-
-    sLog.outString("Loading GameObject models...");
-    LoadGameObjectModelList();
-    sLog.outString();
-
-    sLog.outString("Loading Spell Chain Data...");
-    sSpellMgr.LoadSpellChains();
-
-    sLog.outString("Loading Spell Elixir types...");
-    sSpellMgr.LoadSpellElixirs();
-
-    sLog.outString("Loading Spell Learn Skills...");
-    sSpellMgr.LoadSpellLearnSkills();                       // must be after LoadSpellChains
-
-    sLog.outString("Loading Spell Learn Spells...");
-    sSpellMgr.LoadSpellLearnSpells();
-
-    sLog.outString("Loading Spell Proc Event conditions...");
-    sSpellMgr.LoadSpellProcEvents();
-
-    sLog.outString("Loading Spell Bonus Data...");
-    sSpellMgr.LoadSpellBonuses();                           // must be after LoadSpellChains
-
-    sLog.outString("Loading Spell Proc Item Enchant...");
-    sSpellMgr.LoadSpellProcItemEnchant();                   // must be after LoadSpellChains
-
-    sLog.outString("Loading Aggro Spells Definitions...");
-    sSpellMgr.LoadSpellThreats();
-
-    sLog.outString("Loading NPC Texts...");
-    sObjectMgr.LoadGossipText();
-
-    sLog.outString("Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
-
-    sLog.outString("Loading Item Templates...");            // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr.LoadItemPrototypes();
-
-    sLog.outString("Loading Item converts...");             // must be after LoadItemPrototypes
-    sObjectMgr.LoadItemConverts();
-
-    sLog.outString("Loading Item expire converts...");      // must be after LoadItemPrototypes
-    sObjectMgr.LoadItemExpireConverts();
-
-    sLog.outString("Loading Creature Model Based Info Data...");
-    sObjectMgr.LoadCreatureModelInfo();
-
-    sLog.outString("Loading Equipment templates...");
-    sObjectMgr.LoadEquipmentTemplates();
-
-    sLog.outString("Loading Creature Stats...");
-    sObjectMgr.LoadCreatureClassLvlStats();
-
-    sLog.outString("Loading Creature templates...");
-    sObjectMgr.LoadCreatureTemplates();
-
-    sLog.outString("Loading Creature template spells...");
-    sObjectMgr.LoadCreatureTemplateSpells();
-
-    sLog.outString("Loading Creature Model for race...");   // must be after creature templates
-    sObjectMgr.LoadCreatureModelRace();
-
-    sLog.outString("Loading SpellsScriptTarget...");
-    sSpellMgr.LoadSpellScriptTarget();                      // must be after LoadCreatureTemplates and LoadGameobjectInfo
-
-    sLog.outString("Loading Vehicle Accessory...");         // must be after LoadCreatureTemplates
-    sObjectMgr.LoadVehicleAccessory();
-
-    sLog.outString("Loading ItemRequiredTarget...");
-    sObjectMgr.LoadItemRequiredTarget();
-
-    sLog.outString("Loading Reputation Reward Rates...");
-    sObjectMgr.LoadReputationRewardRate();
-
-    sLog.outString("Loading Creature Reputation OnKill Data...");
-    sObjectMgr.LoadReputationOnKill();
-
-    sLog.outString("Loading Reputation Spillover Data...");
-    sObjectMgr.LoadReputationSpilloverTemplate();
-
-    sLog.outString("Loading Points Of Interest Data...");
-    sObjectMgr.LoadPointsOfInterest();
+    ///- Load templates and other static data; steps without dependencies between them may run in parallel
+    WorldLoader templateLoader;
+    templateLoader.Add("Page Texts", [] { sObjectMgr.LoadPageTexts(); });
+    templateLoader.Add("Game Object Templates", [] { sObjectMgr.LoadGameobjectInfo(); }, { "Page Texts" });
+    templateLoader.Add("GameObject models", [] { LoadGameObjectModelList(); });
+    templateLoader.Add("Spell Chain Data", [] { sSpellMgr.LoadSpellChains(); });
+    templateLoader.Add("Spell Elixir types", [] { sSpellMgr.LoadSpellElixirs(); });
+    templateLoader.Add("Spell Learn Skills", [] { sSpellMgr.LoadSpellLearnSkills(); }, { "Spell Chain Data" });
+    templateLoader.Add("Spell Learn Spells", [] { sSpellMgr.LoadSpellLearnSpells(); }, { "Spell Chain Data" });
+    templateLoader.Add("Spell Proc Event conditions", [] { sSpellMgr.LoadSpellProcEvents(); }, { "Spell Chain Data" });
+    templateLoader.Add("Spell Bonus Data", [] { sSpellMgr.LoadSpellBonuses(); }, { "Spell Chain Data" });
+    templateLoader.Add("Spell Proc Item Enchant", [] { sSpellMgr.LoadSpellProcItemEnchant(); }, { "Spell Chain Data" });
+    templateLoader.Add("Aggro Spells Definitions", [] { sSpellMgr.LoadSpellThreats(); }, { "Spell Chain Data" });
+    templateLoader.Add("NPC Texts", [] { sObjectMgr.LoadGossipText(); });
+    templateLoader.Add("Item Random Enchantments Table", [] { LoadRandomEnchantmentsTable(); });
+    templateLoader.Add("Item Templates", [] { sObjectMgr.LoadItemPrototypes(); }, { "Item Random Enchantments Table", "Page Texts" });
+    templateLoader.Add("Item converts", [] { sObjectMgr.LoadItemConverts(); }, { "Item Templates" });
+    templateLoader.Add("Item expire converts", [] { sObjectMgr.LoadItemExpireConverts(); }, { "Item Templates" });
+    templateLoader.Add("Creature Model Based Info Data", [] { sObjectMgr.LoadCreatureModelInfo(); });
+    templateLoader.Add("Equipment templates", [] { sObjectMgr.LoadEquipmentTemplates(); });
+    templateLoader.Add("Creature Stats", [] { sObjectMgr.LoadCreatureClassLvlStats(); });
+    templateLoader.Add("Creature templates", [] { sObjectMgr.LoadCreatureTemplates(); }, { "Creature Model Based Info Data", "Equipment templates", "Creature Stats" });
+    templateLoader.Add("Creature template spells", [] { sObjectMgr.LoadCreatureTemplateSpells(); }, { "Creature templates" });
+    templateLoader.Add("Creature Model for race", [] { sObjectMgr.LoadCreatureModelRace(); }, { "Creature templates" });
+    templateLoader.Add("SpellsScriptTarget", [] { sSpellMgr.LoadSpellScriptTarget(); }, { "Creature templates", "Game Object Templates" });
+    templateLoader.Add("Vehicle Accessory", [] { sObjectMgr.LoadVehicleAccessory(); }, { "Creature templates" });
+    templateLoader.Add("ItemRequiredTarget", [] { sObjectMgr.LoadItemRequiredTarget(); }, { "Item Templates", "Creature templates", "SpellsScriptTarget" });
+    templateLoader.Add("Reputation Reward Rates", [] { sObjectMgr.LoadReputationRewardRate(); });
+    templateLoader.Add("Creature Reputation OnKill Data", [] { sObjectMgr.LoadReputationOnKill(); }, { "Creature templates" });
+    templateLoader.Add("Reputation Spillover Data", [] { sObjectMgr.LoadReputationSpilloverTemplate(); });
+    templateLoader.Add("Points Of Interest Data", [] { sObjectMgr.LoadPointsOfInterest(); });
+    templateLoader.Run(getConfig(CONFIG_UINT32_STARTUP_LOAD_THREADS));
+    templateLoader.LogReport();
 
     sLog.outString("Loading Creature Data...");
     sObjectMgr.LoadCreatures();
@@ -1646,13 +1616,14 @@ void World::SendWorldText(int32 string_id, ...)
 /// Sends a packet to all players with optional team and instance restrictions
 void World::SendGlobalMessage(WorldPacket const& packet) const
 {
+    PacketBroadcaster broadcaster(packet);
     for (SessionMap::const_iterator itr = m_sessions.cbegin(); itr != m_sessions.cend(); ++itr)
     {
         if (WorldSession* session = itr->second)
         {
             Player* player = session->GetPlayer();
             if (player && player->IsInWorld())
-                session->SendPacket(packet);
+                broadcaster.SendTo(*session);
         }
     }
 }
@@ -89,6 +89,17 @@ enum eConfigUInt32Values
     CONFIG_UINT32_INTERVAL_SAVE,
     CONFIG_UINT32_INTERVAL_GRIDCLEAN,
     CONFIG_UINT32_INTERVAL_MAPUPDATE,
+    CONFIG_UINT32_MAP_UPDATE_THREADS,
+    CONFIG_UINT32_MAP_UPDATE_LONG_TICK_LOG,
+    CONFIG_UINT32_MAP_UPDATE_CONTINENT_THREADS,
+    CONFIG_UINT32_MAP_UPDATE_OBJECT_THREADS,
+    CONFIG_UINT32_STARTUP_LOAD_THREADS,
+    CONFIG_UINT32_SESSION_RECV_QUEUE_LIMIT,
+    CONFIG_UINT32_SESSION_RECV_QUEUE_OVERFLOW,
+    CONFIG_UINT32_NETWORK_FLUSH_DELAY,
+    CONFIG_UINT32_NETWORK_FLUSH_DELAY_RTT_PERCENT,
+    CONFIG_UINT32_NETWORK_FLUSH_DELAY_MIN,
+    CONFIG_UINT32_NETWORK_FLUSH_SIZE,
     CONFIG_UINT32_INTERVAL_CHANGEWEATHER,
     CONFIG_UINT32_PORT_WORLD,
     CONFIG_UINT32_GAME_TYPE,
@@ -345,6 +356,7 @@ enum eConfigBoolValues
     CONFIG_BOOL_OUTDOORPVP_NA_ENABLED,
     CONFIG_BOOL_OUTDOORPVP_GH_ENABLED,
     CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET,
+    CONFIG_BOOL_NETWORK_FLUSH_CRITICAL,
     CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT,
     CONFIG_BOOL_CLEAN_CHARACTER_DB,
     CONFIG_BOOL_VMAP_INDOOR_CHECK,
@@ -0,0 +1,158 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "World/WorldLoader.h"
+#include "Database/DatabaseEnv.h"
+#include "Log.h"
+#include "ProgressBar.h"
+#include "Timer.h"
+
+#include <thread>
+
+void WorldLoader::Add(char const* name, Step const& step, std::initializer_list<char const*> dependencies)
+{
+    uint32 index = m_steps.size();
+    m_steps.push_back(Node(name, step));
+
+    for (char const* dependency : dependencies)
+    {
+        uint32 i = 0;
+        while (i < index && m_steps[i].name != dependency)
+            ++i;
+
+        MANGOS_ASSERT(i < index && "WorldLoader step depends on an unknown or later step");
+        m_steps[index].dependencies.push_back(i);
+        m_steps[i].dependents.push_back(index);
+    }
+}
+
+void WorldLoader::RunStep(Node& node, uint32 runStartTime)
+{
+    uint32 startTime = WorldTimer::getMSTime();
+    node.startTime = WorldTimer::getMSTimeDiff(runStartTime, startTime);
+
+    sLog.outString("Loading %s...", node.name.c_str());
+    node.step();
+
+    node.duration = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+}
+
+void WorldLoader::Run(uint32 numThreads)
+{
+    uint32 runStartTime = WorldTimer::getMSTime();
+    m_numThreads = numThreads;
+
+    if (!numThreads)
+    {
+        for (std::vector<Node>::iterator itr = m_steps.begin(); itr != m_steps.end(); ++itr)
+            RunStep(*itr, runStartTime);
+    }
+    else
+    {
+        // progress bars of steps running at the same time would be mixed up
+        bool showProgress = BarGoLink::GetOutputState();
+        BarGoLink::SetOutputState(false);
+
+        m_finishedSteps = 0;
+        for (uint32 i = 0; i < m_steps.size(); ++i)
+        {
+            m_steps[i].waitingFor = m_steps[i].dependencies.size();
+            if (!m_steps[i].waitingFor)
+                m_readySteps.push(i);
+        }
+
+        std::vector<std::thread> threads;
+        threads.reserve(numThreads);
+        for (uint32 i = 0; i < numThreads; ++i)
+            threads.emplace_back(&WorldLoader::WorkerThread, this, runStartTime);
+
+        for (std::vector<std::thread>::iterator itr = threads.begin(); itr != threads.end(); ++itr)
+            itr->join();
+
+        BarGoLink::SetOutputState(showProgress);
+    }
+
+    m_totalTime = WorldTimer::getMSTimeDiff(runStartTime, WorldTimer::getMSTime());
+}
+
+void WorldLoader::WorkerThread(uint32 runStartTime)
+{
+    WorldDatabase.ThreadStart();                            // the client library needs it for every thread using it
+
+    for (;;)
+    {
+        uint32 index;
+        {
+            std::unique_lock<std::mutex> guard(m_lock);
+            m_stepsChanged.wait(guard, [this] { return !m_readySteps.empty() || m_finishedSteps == m_steps.size(); });
+            if (m_readySteps.empty())
+                break;
+
+            index = m_readySteps.top();
+            m_readySteps.pop();
+        }
+
+        RunStep(m_steps[index], runStartTime);
+
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            ++m_finishedSteps;
+            for (std::vector<uint32>::const_iterator itr = m_steps[index].dependents.begin(); itr != m_steps[index].dependents.end(); ++itr)
+                if (--m_steps[*itr].waitingFor == 0)
+                    m_readySteps.push(*itr);
+        }
+        m_stepsChanged.notify_all();
+    }
+
+    WorldDatabase.ThreadEnd();
+}
+
+void WorldLoader::LogReport() const
+{
+    if (m_steps.empty())
+        return;
+
+    // longest chain of dependent steps ending in each step, dependencies always come first
+    std::vector<uint32> pathTime(m_steps.size());
+    std::vector<int32> pathPrev(m_steps.size(), -1);
+    uint32 last = 0;
+    for (uint32 i = 0; i < m_steps.size(); ++i)
+    {
+        Node const& node = m_steps[i];
+        for (std::vector<uint32>::const_iterator itr = node.dependencies.begin(); itr != node.dependencies.end(); ++itr)
+        {
+            if (pathPrev[i] < 0 || pathTime[*itr] > pathTime[pathPrev[i]])
+                pathPrev[i] = *itr;
+        }
+
+        pathTime[i] = node.duration + (pathPrev[i] < 0 ? 0 : pathTime[pathPrev[i]]);
+        if (pathTime[i] > pathTime[last])
+            last = i;
+    }
+
+    sLog.outString("Startup loading timings (%u steps, %u ms with %u threads):", uint32(m_steps.size()), m_totalTime, m_numThreads);
+    for (std::vector<Node>::const_iterator itr = m_steps.begin(); itr != m_steps.end(); ++itr)
+        sLog.outString("  %7u ms  started at %7u ms  %s", itr->duration, itr->startTime, itr->name.c_str());
+
+    std::string path;
+    for (int32 i = last; i >= 0; i = pathPrev[i])
+        path = path.empty() ? m_steps[i].name : m_steps[i].name + " -> " + path;
+
+    sLog.outString("Critical path (%u ms): %s", pathTime[last], path.c_str());
+    sLog.outString();
+}
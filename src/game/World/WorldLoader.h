@@ -0,0 +1,85 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_WORLDLOADER_H
+#define MANGOS_WORLDLOADER_H
+
+#include "Common.h"
+
+#include <condition_variable>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <vector>
+
+/**
+ * Runs the loading steps of the world startup as a dependency graph.
+ *
+ * Steps are added in their sequential order and name the steps they have to wait for,
+ * which must have been added before them. Without worker threads Run() executes the steps
+ * in the order they were added. With worker threads every step whose dependencies are done
+ * is started right away, earlier added steps first; Run() returns when all steps are done.
+ * Steps running at the same time must not write the same data, so anything a step reads
+ * from another one has to be one of its dependencies.
+ *
+ * LogReport() prints the time of every step and the critical path: the chain of dependent
+ * steps with the longest total time, which bounds the loading time for any number of threads.
+ */
+class WorldLoader
+{
+    public:
+        typedef std::function<void()> Step;
+
+        WorldLoader() : m_numThreads(0), m_totalTime(0), m_finishedSteps(0) {}
+
+        void Add(char const* name, Step const& step, std::initializer_list<char const*> dependencies = {});
+
+        void Run(uint32 numThreads);
+        void LogReport() const;
+
+    private:
+        struct Node
+        {
+            Node(char const* name, Step const& step) : name(name), step(step), waitingFor(0), startTime(0), duration(0) {}
+
+            std::string name;
+            Step step;
+            std::vector<uint32> dependencies;               // indexes of earlier steps
+            std::vector<uint32> dependents;
+            uint32 waitingFor;                              // unfinished dependencies while running
+            uint32 startTime;                               // ms since Run() started
+            uint32 duration;                                // ms
+        };
+
+        void RunStep(Node& node, uint32 runStartTime);
+        void WorkerThread(uint32 runStartTime);
+
+        std::vector<Node> m_steps;
+        uint32 m_numThreads;
+        uint32 m_totalTime;                                 // ms of the last Run()
+
+        // worker thread state, guarded by m_lock
+        std::mutex m_lock;
+        std::condition_variable m_stepsChanged;             // signaled when steps become ready or the last one is done
+        std::priority_queue<uint32, std::vector<uint32>, std::greater<uint32> > m_readySteps;
+        uint32 m_finishedSteps;
+};
+
+#endif
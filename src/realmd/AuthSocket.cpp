@@ -155,12 +155,39 @@ typedef struct AuthHandler
 
 /// Constructor - set the N and g values for SRP6
 AuthSocket::AuthSocket(boost::asio::io_service &service, std::function<void (Socket *)> closeHandler)
-    : Socket(service, closeHandler), _status(STATUS_CHALLENGE), _build(0), _accountSecurityLevel(SEC_PLAYER)
+    : Socket(service, closeHandler), _status(STATUS_CHALLENGE), _accountId(0), _build(0), _accountSecurityLevel(SEC_PLAYER), m_queryPending(false)
 {
     N.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
     g.SetDword(7);
 }
 
+/// Wrap a query continuation, it is called with the result on the network thread of this socket
+std::function<void (QueryResult*)> AuthSocket::ResumeWith(QueryHandler handler)
+{
+    m_queryPending = true;
+
+    std::shared_ptr<AuthSocket> self = shared<AuthSocket>();
+    return [self, handler](QueryResult* result)
+    {
+        self->Post([self, handler, result]()
+        {
+            self->m_queryPending = false;
+
+            if (self->IsClosed())
+            {
+                delete result;
+                return;
+            }
+
+            ((*self).*handler)(result);
+
+            // commands which arrived while the query was pending are still buffered, the socket only reads on new data
+            if (!self->IsClosed() && self->ReadLengthRemaining() > 0 && !self->ProcessIncomingData() && errno != EBADMSG)
+                self->Close();
+        });
+    };
+}
+
 /// Read the packet from the client
 bool AuthSocket::ProcessIncomingData()
 {
@@ -183,6 +210,13 @@ bool AuthSocket::ProcessIncomingData()
     // which presumably the client will never do, but lets support it anyway! \o/
     while (ReadLengthRemaining() > 0)
     {
+        // keep further data buffered until the login database answered the last command
+        if (m_queryPending)
+        {
+            errno = EBADMSG;
+            return false;
+        }
+
         const eAuthCmd cmd = static_cast<eAuthCmd>(*InPeak());
         int i;
 
@@ -340,8 +374,6 @@ bool AuthSocket::_HandleLogonChallenge()
     EndianConvert(ch->timezone_bias);
     EndianConvert(ch->ip);
 
-    ByteBuffer pkt;
-
     _login = (const char*)ch->I;
     _build = ch->build;
 
@@ -353,155 +385,176 @@ bool AuthSocket::_HandleLogonChallenge()
     _safelogin = _login;
     LoginDatabase.escape_string(_safelogin);
 
-    pkt << (uint8) CMD_AUTH_LOGON_CHALLENGE;
-    pkt << (uint8) 0x00;
+    // the packet buffer is gone once the account is loaded, keep the locale
+    _localizationName.resize(4);
+    for (int i = 0; i < 4; ++i)
+        _localizationName[i] = ch->country[4 - i - 1];
 
     ///- Verify that this IP is not in the ip_banned table
     // No SQL injection possible (paste the IP address as passed by the socket)
-    QueryResult* result = LoginDatabase.PQuery("SELECT unbandate FROM ip_banned WHERE "
-                          //    permanent                    still banned
-                          "(unbandate = bandate OR unbandate > UNIX_TIMESTAMP()) AND ip = '%s'", m_address.c_str());
+    return LoginDatabase.AsyncPQuery(ResumeWith(&AuthSocket::_HandleLogonChallengeIpBan), "SELECT unbandate FROM ip_banned WHERE "
+                                     //    permanent                    still banned
+                                     "(unbandate = bandate OR unbandate > UNIX_TIMESTAMP()) AND ip = '%s'", m_address.c_str());
+}
+
+/// Logon Challenge continuation, IP ban check done
+void AuthSocket::_HandleLogonChallengeIpBan(QueryResult* result)
+{
     if (result)
     {
-        pkt << (uint8)WOW_FAIL_BANNED;
         BASIC_LOG("[AuthChallenge] Banned ip %s tries to login!", m_address.c_str());
         delete result;
+        _SendLogonChallengeError(WOW_FAIL_BANNED);
+        return;
     }
-    else
+
+    ///- Get the account details from the account table, together with an active ban if there is one
+    // No SQL injection (escaped user name)
+    if (!LoginDatabase.AsyncPQuery(ResumeWith(&AuthSocket::_HandleLogonChallengeAccount),
+                                   "SELECT a.sha_pass_hash,a.id,a.locked,a.last_ip,a.gmlevel,a.v,a.s,ab.bandate,ab.unbandate FROM account a "
+                                   "LEFT JOIN account_banned ab ON ab.id = a.id AND ab.active = 1 AND (ab.unbandate > UNIX_TIMESTAMP() OR ab.unbandate = ab.bandate) "
+                                   "WHERE a.username = '%s' LIMIT 1", _safelogin.c_str()))
+        Close();
+}
+
+/// Logon Challenge continuation, account loaded
+void AuthSocket::_HandleLogonChallengeAccount(QueryResult* result)
+{
+    if (!result)                                            // no account
     {
-        ///- Get the account details from the account table
-        // No SQL injection (escaped user name)
+        _SendLogonChallengeError(WOW_FAIL_UNKNOWN_ACCOUNT);
+        return;
+    }
 
-        result = LoginDatabase.PQuery("SELECT sha_pass_hash,id,locked,last_ip,gmlevel,v,s FROM account WHERE username = '%s'", _safelogin.c_str());
-        if (result)
+    Field* fields = result->Fetch();
+
+    ///- If the IP is 'locked', check that the player comes indeed from the correct IP address
+    if (fields[2].GetUInt8() == 1)                          // if ip is locked
+    {
+        DEBUG_LOG("[AuthChallenge] Account '%s' is locked to IP - '%s'", _login.c_str(), fields[3].GetString());
+        DEBUG_LOG("[AuthChallenge] Player address is '%s'", m_address.c_str());
+        if (strcmp(fields[3].GetString(), m_address.c_str()))
         {
-            ///- If the IP is 'locked', check that the player comes indeed from the correct IP address
-            bool locked = false;
-            if ((*result)[2].GetUInt8() == 1)               // if ip is locked
-            {
-                DEBUG_LOG("[AuthChallenge] Account '%s' is locked to IP - '%s'", _login.c_str(), (*result)[3].GetString());
-                DEBUG_LOG("[AuthChallenge] Player address is '%s'", m_address.c_str());
-                if (strcmp((*result)[3].GetString(), m_address.c_str()))
-                {
-                    DEBUG_LOG("[AuthChallenge] Account IP differs");
-                    pkt << (uint8) WOW_FAIL_SUSPENDED;
-                    locked = true;
-                }
-                else
-                {
-                    DEBUG_LOG("[AuthChallenge] Account IP matches");
-                }
-            }
-            else
-            {
-                DEBUG_LOG("[AuthChallenge] Account '%s' is not locked to ip", _login.c_str());
-            }
+            DEBUG_LOG("[AuthChallenge] Account IP differs");
+            delete result;
+            _SendLogonChallengeError(WOW_FAIL_SUSPENDED);
+            return;
+        }
+        else
+        {
+            DEBUG_LOG("[AuthChallenge] Account IP matches");
+        }
+    }
+    else
+    {
+        DEBUG_LOG("[AuthChallenge] Account '%s' is not locked to ip", _login.c_str());
+    }
 
-            if (!locked)
-            {
-                ///- If the account is banned, reject the logon attempt
-                QueryResult* banresult = LoginDatabase.PQuery("SELECT bandate,unbandate FROM account_banned WHERE "
-                                         "id = %u AND active = 1 AND (unbandate > UNIX_TIMESTAMP() OR unbandate = bandate)", (*result)[1].GetUInt32());
-                if (banresult)
-                {
-                    if ((*banresult)[0].GetUInt64() == (*banresult)[1].GetUInt64())
-                    {
-                        pkt << (uint8) WOW_FAIL_BANNED;
-                        BASIC_LOG("[AuthChallenge] Banned account %s tries to login!", _login.c_str());
-                    }
-                    else
-                    {
-                        pkt << (uint8) WOW_FAIL_SUSPENDED;
-                        BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!", _login.c_str());
-                    }
-
-                    delete banresult;
-                }
-                else
-                {
-                    ///- Get the password from the account table, upper it, and make the SRP6 calculation
-                    std::string rI = (*result)[0].GetCppString();
-
-                    ///- Don't calculate (v, s) if there are already some in the database
-                    std::string databaseV = (*result)[5].GetCppString();
-                    std::string databaseS = (*result)[6].GetCppString();
-
-                    DEBUG_LOG("database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
-
-                    // multiply with 2, bytes are stored as hexstring
-                    if (databaseV.size() != s_BYTE_SIZE * 2 || databaseS.size() != s_BYTE_SIZE * 2)
-                        _SetVSFields(rI);
-                    else
-                    {
-                        s.SetHexStr(databaseS.c_str());
-                        v.SetHexStr(databaseV.c_str());
-                    }
-
-                    b.SetRand(19 * 8);
-                    BigNumber gmod = g.ModExp(b, N);
-                    B = ((v * 3) + gmod) % N;
-
-                    MANGOS_ASSERT(gmod.GetNumBytes() <= 32);
-
-                    BigNumber unk3;
-                    unk3.SetRand(16 * 8);
-
-                    ///- Fill the response packet with the result
-                    pkt << uint8(WOW_SUCCESS);
-
-                    // B may be calculated < 32B so we force minimal length to 32B
-                    pkt.append(B.AsByteArray(32), 32);      // 32 bytes
-                    pkt << uint8(1);
-                    pkt.append(g.AsByteArray(), 1);
-                    pkt << uint8(32);
-                    pkt.append(N.AsByteArray(32), 32);
-                    pkt.append(s.AsByteArray(), s.GetNumBytes());// 32 bytes
-                    pkt.append(unk3.AsByteArray(16), 16);
-                    uint8 securityFlags = 0;
-                    pkt << uint8(securityFlags);            // security flags (0x0...0x04)
-
-                    if (securityFlags & 0x01)               // PIN input
-                    {
-                        pkt << uint32(0);
-                        pkt << uint64(0) << uint64(0);      // 16 bytes hash?
-                    }
-
-                    if (securityFlags & 0x02)               // Matrix input
-                    {
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint64(0);
-                    }
-
-                    if (securityFlags & 0x04)               // Security token input
-                    {
-                        pkt << uint8(1);
-                    }
-
-                    uint8 secLevel = (*result)[4].GetUInt8();
-                    _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
-
-                    _localizationName.resize(4);
-                    for (int i = 0; i < 4; ++i)
-                        _localizationName[i] = ch->country[4 - i - 1];
-
-                    BASIC_LOG("[AuthChallenge] account %s is using '%c%c%c%c' locale (%u)", _login.c_str(), ch->country[3], ch->country[2], ch->country[1], ch->country[0], GetLocaleByName(_localizationName));
-
-                    ///- All good, await client's proof
-                    _status = STATUS_LOGON_PROOF;
-                }
-            }
+    ///- If the account is banned, reject the logon attempt
+    if (!fields[7].IsNULL())
+    {
+        if (fields[7].GetUInt64() == fields[8].GetUInt64())
+        {
+            BASIC_LOG("[AuthChallenge] Banned account %s tries to login!", _login.c_str());
             delete result;
+            _SendLogonChallengeError(WOW_FAIL_BANNED);
         }
-        else                                                // no account
+        else
         {
-            pkt << (uint8) WOW_FAIL_UNKNOWN_ACCOUNT;
+            BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!", _login.c_str());
+            delete result;
+            _SendLogonChallengeError(WOW_FAIL_SUSPENDED);
         }
+        return;
+    }
+
+    ///- Get the password from the account table, upper it, and make the SRP6 calculation
+    std::string rI = fields[0].GetCppString();
+
+    ///- Don't calculate (v, s) if there are already some in the database
+    std::string databaseV = fields[5].GetCppString();
+    std::string databaseS = fields[6].GetCppString();
+
+    DEBUG_LOG("database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
+
+    // multiply with 2, bytes are stored as hexstring
+    if (databaseV.size() != s_BYTE_SIZE * 2 || databaseS.size() != s_BYTE_SIZE * 2)
+        _SetVSFields(rI);
+    else
+    {
+        s.SetHexStr(databaseS.c_str());
+        v.SetHexStr(databaseV.c_str());
+    }
+
+    b.SetRand(19 * 8);
+    BigNumber gmod = g.ModExp(b, N);
+    B = ((v * 3) + gmod) % N;
+
+    MANGOS_ASSERT(gmod.GetNumBytes() <= 32);
+
+    BigNumber unk3;
+    unk3.SetRand(16 * 8);
+
+    ///- Fill the response packet with the result
+    ByteBuffer pkt;
+    pkt << (uint8) CMD_AUTH_LOGON_CHALLENGE;
+    pkt << (uint8) 0x00;
+    pkt << uint8(WOW_SUCCESS);
+
+    // B may be calculated < 32B so we force minimal length to 32B
+    pkt.append(B.AsByteArray(32), 32);                      // 32 bytes
+    pkt << uint8(1);
+    pkt.append(g.AsByteArray(), 1);
+    pkt << uint8(32);
+    pkt.append(N.AsByteArray(32), 32);
+    pkt.append(s.AsByteArray(), s.GetNumBytes());           // 32 bytes
+    pkt.append(unk3.AsByteArray(16), 16);
+    uint8 securityFlags = 0;
+    pkt << uint8(securityFlags);                            // security flags (0x0...0x04)
+
+    if (securityFlags & 0x01)                               // PIN input
+    {
+        pkt << uint32(0);
+        pkt << uint64(0) << uint64(0);                      // 16 bytes hash?
+    }
+
+    if (securityFlags & 0x02)                               // Matrix input
+    {
+        pkt << uint8(0);
+        pkt << uint8(0);
+        pkt << uint8(0);
+        pkt << uint8(0);
+        pkt << uint64(0);
     }
+
+    if (securityFlags & 0x04)                               // Security token input
+    {
+        pkt << uint8(1);
+    }
+
+    _accountId = fields[1].GetUInt32();
+
+    uint8 secLevel = fields[4].GetUInt8();
+    _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
+
+    delete result;
+
+    BASIC_LOG("[AuthChallenge] account %s is using '%s' locale (%u)", _login.c_str(), _localizationName.c_str(), GetLocaleByName(_localizationName));
+
+    ///- All good, await client's proof
+    _status = STATUS_LOGON_PROOF;
+
+    Write((const char *)pkt.contents(), pkt.size());
+}
+
+/// Send a failed Logon Challenge result, the session stays closed
+void AuthSocket::_SendLogonChallengeError(uint8 error)
+{
+    ByteBuffer pkt;
+    pkt << (uint8) CMD_AUTH_LOGON_CHALLENGE;
+    pkt << (uint8) 0x00;
+    pkt << (uint8) error;
     Write((const char *)pkt.contents(), pkt.size());
-    return true;
 }
 
 /// Logon Proof command handler
@@ -650,41 +703,53 @@ bool AuthSocket::_HandleLogonProof()
             // Increment number of failed logins by one and if it reaches the limit temporarily ban that account or IP
             LoginDatabase.PExecute("UPDATE account SET failed_logins = failed_logins + 1 WHERE username = '%s'", _safelogin.c_str());
 
-            if (QueryResult* loginfail = LoginDatabase.PQuery("SELECT id, failed_logins FROM account WHERE username = '%s'", _safelogin.c_str()))
+            // the client is gone before the result arrives, so the ban is not applied through the socket
+            std::string login = _login;
+            std::string address = m_address;
+            LoginDatabase.AsyncPQuery([login, address, MaxWrongPassCount](QueryResult* loginfail)
             {
-                Field* fields = loginfail->Fetch();
-                uint32 failed_logins = fields[1].GetUInt32();
-
-                if (failed_logins >= MaxWrongPassCount)
-                {
-                    uint32 WrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
-                    bool WrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
-
-                    if (WrongPassBanType)
-                    {
-                        uint32 acc_id = fields[0].GetUInt32();
-                        LoginDatabase.PExecute("INSERT INTO account_banned VALUES ('%u',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban',1)",
-                                               acc_id, WrongPassBanTime);
-                        BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
-                                  _login.c_str(), WrongPassBanTime, failed_logins);
-                    }
-                    else
-                    {
-                        std::string current_ip = m_address;
-                        LoginDatabase.escape_string(current_ip);
-                        LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban')",
-                                               current_ip.c_str(), WrongPassBanTime);
-                        BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
-                                  current_ip.c_str(), WrongPassBanTime, _login.c_str(), failed_logins);
-                    }
-                }
-                delete loginfail;
-            }
+                _HandleWrongPassCount(loginfail, login, address, MaxWrongPassCount);
+            }, "SELECT id, failed_logins FROM account WHERE username = '%s'", _safelogin.c_str());
         }
     }
     return true;
 }
 
+/// Ban the account or IP after too many failed logins, called on the database delay thread
+void AuthSocket::_HandleWrongPassCount(QueryResult* loginfail, std::string const& login, std::string const& address, uint32 MaxWrongPassCount)
+{
+    if (!loginfail)
+        return;
+
+    Field* fields = loginfail->Fetch();
+    uint32 failed_logins = fields[1].GetUInt32();
+
+    if (failed_logins >= MaxWrongPassCount)
+    {
+        uint32 WrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
+        bool WrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
+
+        if (WrongPassBanType)
+        {
+            uint32 acc_id = fields[0].GetUInt32();
+            LoginDatabase.PExecute("INSERT INTO account_banned VALUES ('%u',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban',1)",
+                                   acc_id, WrongPassBanTime);
+            BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
+                      login.c_str(), WrongPassBanTime, failed_logins);
+        }
+        else
+        {
+            std::string current_ip = address;
+            LoginDatabase.escape_string(current_ip);
+            LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban')",
+                                   current_ip.c_str(), WrongPassBanTime);
+            BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
+                      current_ip.c_str(), WrongPassBanTime, login.c_str(), failed_logins);
+        }
+    }
+    delete loginfail;
+}
+
 /// Reconnect Challenge command handler
 bool AuthSocket::_HandleReconnectChallenge()
 {
@@ -728,18 +793,23 @@ bool AuthSocket::_HandleReconnectChallenge()
     EndianConvert(ch->build);
     _build = ch->build;
 
-    QueryResult* result = LoginDatabase.PQuery("SELECT sessionkey FROM account WHERE username = '%s'", _safelogin.c_str());
+    return LoginDatabase.AsyncPQuery(ResumeWith(&AuthSocket::_HandleReconnectChallengeAccount), "SELECT sessionkey, id FROM account WHERE username = '%s'", _safelogin.c_str());
+}
 
+/// Reconnect Challenge continuation, session key loaded
+void AuthSocket::_HandleReconnectChallengeAccount(QueryResult* result)
+{
     // Stop if the account is not found
     if (!result)
     {
         sLog.outError("[ERROR] user %s tried to login and we cannot find his session key in the database.", _login.c_str());
         Close();
-        return false;
+        return;
     }
 
     Field* fields = result->Fetch();
     K.SetHexStr(fields[0].GetString());
+    _accountId = fields[1].GetUInt32();
     delete result;
 
     ///- All good, await client's proof
@@ -753,7 +823,6 @@ bool AuthSocket::_HandleReconnectChallenge()
     pkt.append(_reconnectProof.AsByteArray(16), 16);        // 16 bytes random
     pkt << (uint64) 0x00 << (uint64) 0x00;                  // 16 bytes zeros
     Write((const char *)pkt.contents(), pkt.size());
-    return true;
 }
 
 /// Reconnect Proof command handler
@@ -811,27 +880,29 @@ bool AuthSocket::_HandleRealmList()
 
     ReadSkip(5);
 
-    ///- Get the user id (else close the connection)
-    // No SQL injection (escaped user name)
+    ///- Get the number of user characters on all realms at once
+    // No SQL injection. id of account is controlled by the database.
+    return LoginDatabase.AsyncPQuery(ResumeWith(&AuthSocket::_HandleRealmListCharacters), "SELECT realmid, numchars FROM realmcharacters WHERE acctid = '%u'", _accountId);
+}
 
-    QueryResult* result = LoginDatabase.PQuery("SELECT id,sha_pass_hash FROM account WHERE username = '%s'", _safelogin.c_str());
-    if (!result)
+/// %Realm List continuation, character counts loaded
+void AuthSocket::_HandleRealmListCharacters(QueryResult* result)
+{
+    CharacterCounts counts;
+    if (result)
     {
-        sLog.outError("[ERROR] user %s tried to login and we cannot find him in the database.", _login.c_str());
-        Close();
-        return false;
+        do
+        {
+            Field* fields = result->Fetch();
+            counts[fields[0].GetUInt32()] = fields[1].GetUInt8();
+        }
+        while (result->NextRow());
+        delete result;
     }
 
-    uint32 id = (*result)[0].GetUInt32();
-    std::string rI = (*result)[1].GetCppString();
-    delete result;
-
-    ///- Update realm list if need
-    sRealmList.UpdateIfNeed();
-
     ///- Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
     ByteBuffer pkt;
-    LoadRealmlist(pkt, id);
+    LoadRealmlist(pkt, counts);
 
     ByteBuffer hdr;
     hdr << (uint8) CMD_REALM_LIST;
@@ -839,12 +910,12 @@ bool AuthSocket::_HandleRealmList()
     hdr.append(pkt);
 
     Write((const char *)hdr.contents(), hdr.size());
-
-    return true;
 }
 
-void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid)
+void AuthSocket::LoadRealmlist(ByteBuffer& pkt, CharacterCounts const& counts)
 {
+    RealmList::RealmMapPtr realms = sRealmList.GetRealms();
+
     switch (_build)
     {
         case 5875:                                          // 1.12.1
@@ -852,22 +923,12 @@ void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid)
         case 6141:                                          // 1.12.3
         {
             pkt << uint32(0);                               // unused value
-            pkt << uint8(sRealmList.size());
+            pkt << uint8(realms->size());
 
-            for (RealmList::RealmMap::const_iterator  i = sRealmList.begin(); i != sRealmList.end(); ++i)
+            for (RealmList::RealmMap::const_iterator  i = realms->begin(); i != realms->end(); ++i)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult* result = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i->second.m_ID, acctid);
-                if (result)
-                {
-                    Field* fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                    delete result;
-                }
-                else
-                    AmountOfCharacters = 0;
+                CharacterCounts::const_iterator count = counts.find(i->second.m_ID);
+                uint8 AmountOfCharacters = count != counts.end() ? count->second : 0;
 
                 bool ok_build = std::find(i->second.realmbuilds.begin(), i->second.realmbuilds.end(), _build) != i->second.realmbuilds.end();
 
@@ -913,22 +974,12 @@ void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid)
         default:                                            // and later
         {
             pkt << uint32(0);                               // unused value
-            pkt << uint16(sRealmList.size());
+            pkt << uint16(realms->size());
 
-            for (RealmList::RealmMap::const_iterator  i = sRealmList.begin(); i != sRealmList.end(); ++i)
+            for (RealmList::RealmMap::const_iterator  i = realms->begin(); i != realms->end(); ++i)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult* result = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i->second.m_ID, acctid);
-                if (result)
-                {
-                    Field* fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                    delete result;
-                }
-                else
-                    AmountOfCharacters = 0;
+                CharacterCounts::const_iterator count = counts.find(i->second.m_ID);
+                uint8 AmountOfCharacters = count != counts.end() ? count->second : 0;
 
                 bool ok_build = std::find(i->second.realmbuilds.begin(), i->second.realmbuilds.end(), _build) != i->second.realmbuilds.end();
 
@@ -34,6 +34,8 @@
 
 #include <functional>
 
+class QueryResult;
+
 class AuthSocket : public MaNGOS::Socket
 {
     public:
@@ -42,13 +44,25 @@ class AuthSocket : public MaNGOS::Socket
         AuthSocket(boost::asio::io_service &service, std::function<void (Socket *)> closeHandler);
 
         void SendProof(Sha1Hash sha);
-        void LoadRealmlist(ByteBuffer& pkt, uint32 acctid);
+        typedef std::map<uint32, uint8> CharacterCounts;    // realm id -> number of account characters
+
+        void LoadRealmlist(ByteBuffer& pkt, CharacterCounts const& counts);
 
         bool _HandleLogonChallenge();
         bool _HandleLogonProof();
         bool _HandleReconnectChallenge();
         bool _HandleReconnectProof();
         bool _HandleRealmList();
+
+        // continuations of the handlers above, called once their login database query is done
+        void _HandleLogonChallengeIpBan(QueryResult* result);
+        void _HandleLogonChallengeAccount(QueryResult* result);
+        void _HandleReconnectChallengeAccount(QueryResult* result);
+        void _HandleRealmListCharacters(QueryResult* result);
+        static void _HandleWrongPassCount(QueryResult* loginfail, std::string const& login, std::string const& address, uint32 MaxWrongPassCount);
+
+        void _SendLogonChallengeError(uint8 error);
+
         // data transfer handle for patch
 
         bool _HandleXferResume();
@@ -58,6 +72,10 @@ class AuthSocket : public MaNGOS::Socket
         void _SetVSFields(const std::string& rI);
 
     private:
+        typedef void (AuthSocket::*QueryHandler)(QueryResult*);
+
+        std::function<void (QueryResult*)> ResumeWith(QueryHandler handler);
+
         enum eStatus
         {
             STATUS_CHALLENGE,
@@ -77,6 +95,7 @@ class AuthSocket : public MaNGOS::Socket
 
         std::string _login;
         std::string _safelogin;
+        uint32 _accountId;
 
         // Since GetLocaleByName() is _NOT_ bijective, we have to store the locale as a string. Otherwise we can't differ
         // between enUS and enGB, which is important for the patch system
@@ -84,6 +103,8 @@ class AuthSocket : public MaNGOS::Socket
         uint16 _build;
         AccountTypes _accountSecurityLevel;
 
+        bool m_queryPending;                                // a handler waits for its login database query, input is held back
+
         virtual bool ProcessIncomingData() override;
 };
 #endif
@@ -188,7 +188,7 @@ int main(int argc, char *argv[])
 
     ///- Get the list of realms for the server
     sRealmList.Initialize(sConfig.GetIntDefault("RealmsStateUpdateDelay", 20));
-    if (sRealmList.size() == 0)
+    if (sRealmList.GetRealms()->empty())
     {
         sLog.outError("No valid realms specified.");
         Log::WaitBeforeContinueIfNeed();
@@ -205,8 +205,14 @@ int main(int argc, char *argv[])
     auto rmport = sConfig.GetIntDefault("RealmServerPort", DEFAULT_REALMSERVER_PORT);
     std::string bind_ip = sConfig.GetStringDefault("BindIP", "0.0.0.0");
 
-    // FIXME - more intelligent selection of thread count is needed here.  config option?
-    MaNGOS::Listener<AuthSocket> listener(rmport, 1);
+    int networkThreads = sConfig.GetIntDefault("Network.Threads", 1);
+    if (networkThreads < 1)
+    {
+        sLog.outError("Network.Threads (%i) must be at least 1, using 1.", networkThreads);
+        networkThreads = 1;
+    }
+
+    MaNGOS::Listener<AuthSocket> listener(rmport, networkThreads);
 
     ///- Catch termination signals
     HookSignals();
@@ -273,6 +279,10 @@ int main(int argc, char *argv[])
             DETAIL_LOG("Ping MySQL to keep connection alive");
             LoginDatabase.Ping();
         }
+
+        ///- Reload the realm list if the delay expired, network threads keep using the previous list meanwhile
+        sRealmList.UpdateIfNeed();
+
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
 #ifdef _WIN32
         if (m_ServiceStatus == 0) stopEvent = true;
@@ -64,7 +64,7 @@ RealmBuildInfo const* FindBuildInfo(uint16 _build)
     return nullptr;
 }
 
-RealmList::RealmList() : m_UpdateInterval(0), m_NextUpdateTime(time(nullptr))
+RealmList::RealmList() : m_realms(new RealmMap), m_UpdateInterval(0), m_NextUpdateTime(time(nullptr))
 {
 }
 
@@ -83,10 +83,10 @@ void RealmList::Initialize(uint32 updateInterval)
     UpdateRealms(true);
 }
 
-void RealmList::UpdateRealm(uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds)
+void RealmList::UpdateRealm(RealmMap& realms, uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds)
 {
     ///- Create new if not exist or update existed
-    Realm& realm = m_realms[name];
+    Realm& realm = realms[name];
 
     realm.m_ID       = ID;
     realm.icon       = icon;
@@ -131,9 +131,6 @@ void RealmList::UpdateIfNeed()
 
     m_NextUpdateTime = time(nullptr) + m_UpdateInterval;
 
-    // Clears Realm list
-    m_realms.clear();
-
     // Get the content of the realmlist table in the database
     UpdateRealms(false);
 }
@@ -142,6 +139,8 @@ void RealmList::UpdateRealms(bool init)
 {
     DETAIL_LOG("Updating Realm List...");
 
+    RealmMap* realms = new RealmMap;
+
     ////                                               0   1     2        3     4     5           6         7                     8           9
     QueryResult* result = LoginDatabase.Query("SELECT id, name, address, port, icon, realmflags, timezone, allowedSecurityLevel, population, realmbuilds FROM realmlist WHERE (realmflags & 1) = 0 ORDER BY name");
 
@@ -164,7 +163,7 @@ void RealmList::UpdateRealms(bool init)
             }
 
             UpdateRealm(
-                Id, name, fields[2].GetCppString(), fields[3].GetUInt32(),
+                *realms, Id, name, fields[2].GetCppString(), fields[3].GetUInt32(),
                 fields[4].GetUInt8(), RealmFlags(realmflags), fields[6].GetUInt8(),
                 (allowedSecurityLevel <= SEC_ADMINISTRATOR ? AccountTypes(allowedSecurityLevel) : SEC_ADMINISTRATOR),
                 fields[8].GetFloat(), fields[9].GetCppString());
@@ -175,4 +174,7 @@ void RealmList::UpdateRealms(bool init)
         while (result->NextRow());
         delete result;
     }
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_realms.reset(realms);
 }
@@ -25,6 +25,9 @@
 
 #include "Common.h"
 
+#include <memory>
+#include <mutex>
+
 struct RealmBuildInfo
 {
     int build;
@@ -53,10 +56,12 @@ struct Realm
 };
 
 /// Storage object for the list of realms on the server
+/// The list is replaced as a whole on update, so network threads can keep using the snapshot they got from GetRealms()
 class RealmList
 {
     public:
         typedef std::map<std::string, Realm> RealmMap;
+        typedef std::shared_ptr<RealmMap const> RealmMapPtr;
 
         static RealmList& Instance();
 
@@ -67,14 +72,17 @@ class RealmList
 
         void UpdateIfNeed();
 
-        RealmMap::const_iterator begin() const { return m_realms.begin(); }
-        RealmMap::const_iterator end() const { return m_realms.end(); }
-        uint32 size() const { return m_realms.size(); }
+        RealmMapPtr GetRealms() const
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            return m_realms;
+        }
     private:
         void UpdateRealms(bool init);
-        void UpdateRealm(uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds);
+        static void UpdateRealm(RealmMap& realms, uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds);
     private:
-        RealmMap m_realms;                                  ///< Internal map of realms
+        mutable std::mutex m_lock;                          ///< Guards the m_realms pointer, not the map it points to
+        RealmMapPtr m_realms;                               ///< Internal map of realms
         uint32   m_UpdateInterval;
         time_t   m_NextUpdateTime;
 };
@@ -0,0 +1,320 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "DBCImage.h"
+#include "DBCFileLoader.h"
+#include "Log.h"
+
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <map>
+#include <sys/stat.h>
+
+#if PLATFORM != PLATFORM_WINDOWS
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define DBC_IMAGE_MAGIC         0x49434244                  // "DBCI"
+#define DBC_IMAGE_VERSION       2
+#define DBC_IMAGE_ALIGNMENT     16                          // of the tables inside an image
+#define DBC_IMAGE_BASE_ADDRESS  uint64(0x500000000000ULL)   // of the first slot, above the usual heap and library ranges
+#define DBC_IMAGE_SLOT_SIZE     uint64(0x40000000ULL)       // address space of an image, far more than the largest store needs
+#define DBC_IMAGE_SLOT_COUNT    0xC000                      // slots up to the end of the user address space
+
+struct DBCImageHeader
+{
+    uint32 magic;
+    uint32 version;
+    uint64 baseAddress;                                     // all pointers in the image are only valid at this address
+    uint64 imageSize;
+    uint32 recordSize;
+    uint32 indexCount;
+    uint32 recordCount;
+    uint32 keySize;                                         // format and sources, right after the header
+    uint64 indexOffset;
+    uint64 dataOffset;
+    uint64 stringOffset;
+};
+
+std::string DBCImage::m_directory;
+std::set<uint32> DBCImage::m_usedSlots;
+
+static uint64 AlignImageOffset(uint64 offset, uint64 alignment)
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+// everything an image depends on besides its own layout
+static std::string BuildImageKey(char const* format, DBCImage::SourceList const& sources)
+{
+    std::string key(format, strlen(format) + 1);
+    for (DBCImage::SourceList::const_iterator itr = sources.begin(); itr != sources.end(); ++itr)
+    {
+        key.append(itr->name.c_str(), itr->name.size() + 1);
+        key.append((char const*)&itr->size, sizeof(itr->size));
+        key.append((char const*)&itr->modified, sizeof(itr->modified));
+    }
+    return key;
+}
+
+DBCImage::Source::Source(std::string const& dbcPath, std::string const& name) : name(name), size(0), modified(0)
+{
+    struct stat fileStat;
+    if (stat((dbcPath + name).c_str(), &fileStat) == 0)
+    {
+        size = fileStat.st_size;
+        modified = fileStat.st_mtime;
+    }
+}
+
+void DBCImage::SetDirectory(std::string const& dir)
+{
+    m_directory.clear();
+    if (dir.empty())
+        return;
+
+#if PLATFORM == PLATFORM_WINDOWS
+    sLog.outError("DBC images are not supported on this platform, loading DBC files.");
+#else
+    // images are mapped at fixed addresses above the usual heap and library ranges
+    if (sizeof(void*) < 8)
+    {
+        sLog.outError("DBC images need a 64 bit build, loading DBC files.");
+        return;
+    }
+
+    m_directory = dir;
+    if (m_directory[m_directory.size() - 1] != '/' && m_directory[m_directory.size() - 1] != '\\')
+        m_directory += '/';
+#endif
+}
+
+std::string DBCImage::GetFileName(char const* name)
+{
+    return m_directory + name + ".img";
+}
+
+// slot of a store is taken from its name only, the next free one if another store already uses it
+uint32 DBCImage::GetFreeSlot(char const* name)
+{
+    uint32 hash = 2166136261u;                              // FNV-1a
+    for (char const* c = name; *c; ++c)
+        hash = (hash ^ uint8(*c)) * 16777619u;
+
+    uint32 slot = hash % DBC_IMAGE_SLOT_COUNT;
+    while (m_usedSlots.find(slot) != m_usedSlots.end())
+        slot = (slot + 1) % DBC_IMAGE_SLOT_COUNT;
+    return slot;
+}
+
+bool DBCImage::Save(char const* name, char const* format, uint32 recordSize, SourceList const& sources,
+                    char* const* indexTable, uint32 indexCount, char const* dataTable, uint32 recordCount)
+{
+    std::string key = BuildImageKey(format, sources);
+
+    DBCImageHeader header;
+    header.magic = DBC_IMAGE_MAGIC;
+    header.version = DBC_IMAGE_VERSION;
+    uint32 slot = GetFreeSlot(name);
+    header.baseAddress = DBC_IMAGE_BASE_ADDRESS + slot * DBC_IMAGE_SLOT_SIZE;
+    header.recordSize = recordSize;
+    header.indexCount = indexCount;
+    header.recordCount = recordCount;
+    header.keySize = key.size();
+    header.indexOffset = AlignImageOffset(sizeof(header) + key.size(), DBC_IMAGE_ALIGNMENT);
+    header.dataOffset = AlignImageOffset(header.indexOffset + uint64(indexCount) * sizeof(char*), DBC_IMAGE_ALIGNMENT);
+    header.stringOffset = header.dataOffset + uint64(recordCount) * recordSize;
+
+    std::vector<char> data(dataTable, dataTable + uint64(recordCount) * recordSize);
+    std::vector<char> strings;
+
+    // strings are shared between records and locales, store each one once
+    std::map<char const*, uint64> stringOffsets;
+    for (uint32 y = 0; y < recordCount; ++y)
+    {
+        uint64 offset = uint64(y) * recordSize;
+        for (uint32 x = 0; format[x]; ++x)
+        {
+            switch (format[x])
+            {
+                case FT_FLOAT:
+                case FT_IND:
+                case FT_INT:
+                    offset += sizeof(uint32);
+                    break;
+                case FT_BYTE:
+                    offset += sizeof(uint8);
+                    break;
+                case FT_STRING:
+                {
+                    char const* value = *(char* const*)&dataTable[offset];
+                    uint64 address = 0;
+                    if (value)
+                    {
+                        std::map<char const*, uint64>::const_iterator itr = stringOffsets.find(value);
+                        if (itr == stringOffsets.end())
+                        {
+                            itr = stringOffsets.insert(std::make_pair(value, uint64(strings.size()))).first;
+                            strings.insert(strings.end(), value, value + strlen(value) + 1);
+                        }
+                        address = header.baseAddress + header.stringOffset + itr->second;
+                    }
+                    *(char**)&data[offset] = (char*)uintptr_t(address);
+                    offset += sizeof(char*);
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+
+    header.imageSize = header.stringOffset + strings.size();
+    if (header.imageSize > DBC_IMAGE_SLOT_SIZE)
+    {
+        sLog.outError("DBC image %s not written, store does not fit in an image slot.", name);
+        return false;
+    }
+
+    std::vector<char*> index(indexCount, nullptr);
+    for (uint32 i = 0; i < indexCount; ++i)
+    {
+        if (!indexTable[i])
+            continue;
+
+        uint64 offset = indexTable[i] - dataTable;
+        if (indexTable[i] < dataTable || offset >= data.size())
+        {
+            sLog.outError("DBC image %s not written, store has entries outside of its data table.", name);
+            return false;
+        }
+        index[i] = (char*)uintptr_t(header.baseAddress + header.dataOffset + offset);
+    }
+
+    std::string fileName = GetFileName(name);
+    std::string tmpFileName = fileName + ".tmp";
+    FILE* file = fopen(tmpFileName.c_str(), "wb");
+    if (!file)
+    {
+        sLog.outError("Can not create DBC image file %s", tmpFileName.c_str());
+        return false;
+    }
+
+    char const padding[DBC_IMAGE_ALIGNMENT] = {};
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(key.data(), 1, key.size(), file) == key.size() &&
+              fwrite(padding, 1, header.indexOffset - sizeof(header) - key.size(), file) == header.indexOffset - sizeof(header) - key.size() &&
+              (index.empty() || fwrite(&index[0], sizeof(char*), index.size(), file) == index.size()) &&
+              fwrite(padding, 1, header.dataOffset - header.indexOffset - index.size() * sizeof(char*), file) == header.dataOffset - header.indexOffset - index.size() * sizeof(char*) &&
+              (data.empty() || fwrite(&data[0], 1, data.size(), file) == data.size()) &&
+              (strings.empty() || fwrite(&strings[0], 1, strings.size(), file) == strings.size());
+    ok = fclose(file) == 0 && ok;
+
+    // replace the old image only with a completely written one, processes still mapping it keep the old file
+    if (!ok || (remove(fileName.c_str()) != 0 && errno != ENOENT) || rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+    {
+        sLog.outError("Can not write DBC image file %s", fileName.c_str());
+        remove(tmpFileName.c_str());
+        return false;
+    }
+
+    m_usedSlots.insert(slot);
+    return true;
+}
+
+bool DBCImage::Open(char const* name, char const* format, uint32 recordSize, SourceList const& sources)
+{
+    Close();
+
+#if PLATFORM == PLATFORM_WINDOWS
+    return false;
+#else
+    std::string fileName = GetFileName(name);
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    DBCImageHeader header;
+    struct stat fileStat;
+    if (read(fd, &header, sizeof(header)) != sizeof(header) || fstat(fd, &fileStat) != 0 ||
+            header.magic != DBC_IMAGE_MAGIC || header.version != DBC_IMAGE_VERSION || header.recordSize != recordSize ||
+            uint64(fileStat.st_size) != header.imageSize || header.stringOffset > header.imageSize ||
+            header.baseAddress < DBC_IMAGE_BASE_ADDRESS || (header.baseAddress - DBC_IMAGE_BASE_ADDRESS) % DBC_IMAGE_SLOT_SIZE != 0 ||
+            (header.baseAddress - DBC_IMAGE_BASE_ADDRESS) / DBC_IMAGE_SLOT_SIZE >= DBC_IMAGE_SLOT_COUNT || header.imageSize > DBC_IMAGE_SLOT_SIZE ||
+            header.indexOffset + uint64(header.indexCount) * sizeof(char*) > header.dataOffset ||
+            header.dataOffset + uint64(header.recordCount) * recordSize > header.stringOffset)
+    {
+        close(fd);
+        return false;
+    }
+
+    // never replace other mappings, an image which does not get its address is loaded from the DBC files
+    int flags = MAP_PRIVATE;
+#ifdef MAP_FIXED_NOREPLACE
+    flags |= MAP_FIXED_NOREPLACE;
+#endif
+    void* base = mmap((void*)uintptr_t(header.baseAddress), header.imageSize, PROT_READ | PROT_WRITE, flags, fd, 0);
+    close(fd);
+
+    if (base == MAP_FAILED)
+    {
+        sLog.outDetail("DBC image %s can not be mapped at its address, loading DBC files.", fileName.c_str());
+        return false;
+    }
+
+    m_base = (char*)base;
+    m_size = header.imageSize;
+
+    if (uintptr_t(base) != header.baseAddress)
+    {
+        sLog.outDetail("DBC image %s can not be mapped at its address, loading DBC files.", fileName.c_str());
+        Close();
+        return false;
+    }
+
+    std::string key = BuildImageKey(format, sources);
+    if (header.keySize != key.size() || sizeof(header) + key.size() > header.indexOffset || memcmp(m_base + sizeof(header), key.data(), key.size()) != 0)
+    {
+        Close();
+        return false;
+    }
+
+    m_indexCount = header.indexCount;
+    m_indexOffset = header.indexOffset;
+    m_dataOffset = header.dataOffset;
+
+    m_usedSlots.insert(uint32((header.baseAddress - DBC_IMAGE_BASE_ADDRESS) / DBC_IMAGE_SLOT_SIZE));
+    return true;
+#endif
+}
+
+void DBCImage::Close()
+{
+    if (!m_base)
+        return;
+
+#if PLATFORM != PLATFORM_WINDOWS
+    munmap(m_base, m_size);
+#endif
+    m_base = nullptr;
+    m_size = 0;
+    m_indexCount = 0;
+}
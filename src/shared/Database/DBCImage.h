@@ -0,0 +1,99 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DBC_IMAGE_H
+#define DBC_IMAGE_H
+
+#include "Platform/Define.h"
+
+#include <string>
+#include <vector>
+#include <set>
+
+/**
+ * Memory image of a loaded DBC store, mapped from a file instead of parsing the DBC files.
+ *
+ * An image holds the index table, the records and the strings of a store laid out as
+ * DBCStorage keeps them in memory, with all pointers already resolved for the fixed address
+ * the image was built for. Mapped at that address the store is usable as is, and since the
+ * pages come from the file they are shared by all servers on a host using the same image
+ * directory. The mapping is copy on write, so the few places changing DBC data at runtime
+ * only get a private copy of the page they touch.
+ *
+ * Each image gets its own slot of address space chosen by the name of its store, so an image
+ * changing size does not move the address of any other image.
+ *
+ * An image is only used while the DBC files it was built from (main and locale files) have
+ * the same size and modification time. A stale image, or one which can not be mapped at its
+ * address, is ignored and the store is loaded from the DBC files and written again.
+ */
+class DBCImage
+{
+    public:
+        // DBC file a store is built from, the name is relative to the dbc directory
+        struct Source
+        {
+            Source(std::string const& dbcPath, std::string const& name);
+
+            bool Exists() const { return size != 0; }
+            bool operator==(Source const& other) const { return name == other.name && size == other.size && modified == other.modified; }
+
+            std::string name;
+            uint64 size;
+            uint64 modified;
+        };
+        typedef std::vector<Source> SourceList;
+
+        // enables images, stored in dir; an empty dir disables them
+        static void SetDirectory(std::string const& dir);
+        static bool IsEnabled() { return !m_directory.empty(); }
+
+        // write an image of a store loaded from the DBC files
+        static bool Save(char const* name, char const* format, uint32 recordSize, SourceList const& sources,
+                         char* const* indexTable, uint32 indexCount, char const* dataTable, uint32 recordCount);
+
+        DBCImage() : m_base(nullptr), m_size(0), m_indexCount(0), m_indexOffset(0), m_dataOffset(0) {}
+        ~DBCImage() { Close(); }
+
+        DBCImage(DBCImage const&) = delete;
+        DBCImage& operator=(DBCImage const&) = delete;
+
+        // map the image of a store, false if there is none or it is stale or can not be mapped at its address
+        bool Open(char const* name, char const* format, uint32 recordSize, SourceList const& sources);
+        void Close();
+        bool IsOpen() const { return m_base != nullptr; }
+
+        char* GetIndexTable() const { return m_base + m_indexOffset; }
+        char* GetDataTable() const { return m_base + m_dataOffset; }
+        uint32 GetIndexCount() const { return m_indexCount; }
+
+    private:
+        static std::string GetFileName(char const* name);
+        static uint32 GetFreeSlot(char const* name);
+
+        static std::string m_directory;
+        static std::set<uint32> m_usedSlots;                // address slots of the images mapped or built by this process
+
+        char* m_base;
+        uint64 m_size;
+        uint32 m_indexCount;
+        uint64 m_indexOffset;
+        uint64 m_dataOffset;
+};
+
+#endif
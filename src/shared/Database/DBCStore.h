@@ -20,13 +20,14 @@
 #define DBCSTORE_H
 
 #include "DBCFileLoader.h"
+#include "DBCImage.h"
 
 template<class T>
 class DBCStorage
 {
         typedef std::list<char*> StringPoolList;
     public:
-        explicit DBCStorage(const char* f) : nCount(0), fieldCount(0), fmt(f), indexTable(nullptr), m_dataTable(nullptr) { }
+        explicit DBCStorage(const char* f) : nCount(0), fieldCount(0), fmt(f), indexTable(nullptr), m_dataTable(nullptr), m_recordCount(0) { }
         ~DBCStorage() { Clear(); }
 
         T const* LookupEntry(uint32 id) const { return (id >= nCount) ? nullptr : indexTable[id]; }
@@ -45,6 +46,7 @@ class DBCStorage
 
             // load raw non-string data
             m_dataTable = (T*)dbc.AutoProduceData(fmt, nCount, (char**&)indexTable);
+            m_recordCount = dbc.GetNumRows();
 
             // load strings from dbc data
             m_stringPoolList.push_back(dbc.AutoProduceStrings(fmt, (char*)m_dataTable));
@@ -70,8 +72,42 @@ class DBCStorage
             return true;
         }
 
+        // use an up to date image built from the sources instead of loading them, see DBCImage
+        bool LoadImage(char const* name, DBCImage::SourceList const& sources)
+        {
+            Clear();
+
+            if (!m_image.Open(name, fmt, sizeof(T), sources))
+                return false;
+
+            fieldCount = strlen(fmt);
+            nCount = m_image.GetIndexCount();
+            indexTable = (T**)m_image.GetIndexTable();
+            m_dataTable = (T*)m_image.GetDataTable();
+            m_recordCount = 0;
+            return true;
+        }
+
+        // write an image of the store loaded from the sources
+        bool SaveImage(char const* name, DBCImage::SourceList const& sources) const
+        {
+            if (!indexTable || m_image.IsOpen())
+                return false;
+
+            return DBCImage::Save(name, fmt, sizeof(T), sources, (char* const*)indexTable, nCount, (char const*)m_dataTable, m_recordCount);
+        }
+
         void Clear()
         {
+            if (m_image.IsOpen())
+            {
+                m_image.Close();
+                indexTable = nullptr;
+                m_dataTable = nullptr;
+                nCount = 0;
+                return;
+            }
+
             if (!indexTable)
                 return;
 
@@ -97,7 +133,9 @@ class DBCStorage
         char const* fmt;
         T** indexTable;
         T* m_dataTable;
+        uint32 m_recordCount;                               // records in m_dataTable
         StringPoolList m_stringPoolList;
+        DBCImage m_image;                                   // index, data and strings are mapped from it while open
 };
 
 #endif
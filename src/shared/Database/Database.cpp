@@ -91,6 +91,68 @@ bool SqlConnection::ExecuteStmt(int nIndex, const SqlStmtParameters& id)
     return pStmt->execute();
 }
 
+QueryResult* SqlConnection::QueryStmt(int nIndex, const SqlStmtParameters& id)
+{
+    if (nIndex == -1)
+        return nullptr;
+
+    SqlPreparedStatement* pStmt = GetStmt(nIndex);
+    if (!pStmt->isQuery())
+    {
+        sLog.outError("SQL ERROR: statement does not return a result set: %s", m_db.GetStmtString(nIndex).c_str());
+        return nullptr;
+    }
+
+    pStmt->bind(id);
+    return pStmt->query();
+}
+
+QueryResult* SqlConnection::QueryStmtStream(int nIndex, const SqlStmtParameters& id)
+{
+    if (nIndex == -1)
+        return nullptr;
+
+    SqlPreparedStatement* pStmt = GetStmt(nIndex);
+    if (!pStmt->isQuery())
+    {
+        sLog.outError("SQL ERROR: statement does not return a result set: %s", m_db.GetStmtString(nIndex).c_str());
+        return nullptr;
+    }
+
+    pStmt->bind(id);
+    return pStmt->queryStream();
+}
+
+// keeps the connection of a streamed result busy until the result is deleted
+class QueryResultStream : public QueryResult
+{
+    public:
+        QueryResultStream(QueryResult* result, Database& db, SqlConnection* conn)
+            : QueryResult(0, result->GetFieldCount()), m_result(result), m_db(db), m_conn(conn)
+        {
+            mCurrentRow = m_result->Fetch();
+        }
+
+        ~QueryResultStream()
+        {
+            // drops the unread rest of the result set
+            delete m_result;
+            m_db.ReleaseStreamConnection(m_conn);
+        }
+
+        bool NextRow() override
+        {
+            bool next = m_result->NextRow();
+            mCurrentRow = m_result->Fetch();
+            return next;
+        }
+
+    private:
+        QueryResult* m_result;
+        Database& m_db;
+        SqlConnection* m_conn;
+};
+
 //////////////////////////////////////////////////////////////////////////
 Database::~Database()
 {
@@ -110,6 +172,7 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
     }
 
     m_pingIntervallms = sConfig.GetIntDefault("MaxPingTime", 30) * (MINUTE * 1000);
+    m_infoString = infoString;
 
     // create DB connections
 
@@ -155,6 +218,11 @@ void Database::StopServer()
     m_pResultQueue = nullptr;
     m_pAsyncConn = nullptr;
 
+    for (size_t i = 0; i < m_pStreamConnections.size(); ++i)
+        delete m_pStreamConnections[i];
+
+    m_pStreamConnections.clear();
+
     for (size_t i = 0; i < m_pQueryConnections.size(); ++i)
         delete m_pQueryConnections[i];
 
@@ -239,6 +307,10 @@ void Database::Ping()
         SqlConnection::Lock guard(m_pQueryConnections[i]);
         delete guard->Query(sql);
     }
+
+    std::lock_guard<std::mutex> guard(m_streamConnLock);
+    for (size_t i = 0; i < m_pStreamConnections.size(); ++i)
+        delete m_pStreamConnections[i]->Query(sql);
 }
 
 bool Database::PExecuteLog(const char* format, ...)
@@ -304,6 +376,80 @@ QueryResult* Database::PQuery(const char* format, ...)
     return Query(szQuery);
 }
 
+QueryResult* Database::StreamQuery(const char* sql)
+{
+    SqlConnection* conn = AcquireStreamConnection();
+    if (!conn)
+        return nullptr;
+
+    QueryResult* result = conn->QueryStream(sql);
+    if (!result)
+    {
+        ReleaseStreamConnection(conn);
+        return nullptr;
+    }
+
+    return new QueryResultStream(result, *this, conn);
+}
+
+uint32 Database::GetTableRowCount(const char* table)
+{
+    QueryResult* result = PQuery("SELECT COUNT(*) FROM %s", table);
+    if (!result)
+        return 0;
+
+    uint32 rowCount = result->Fetch()[0].GetUInt32();
+    delete result;
+    return rowCount;
+}
+
+QueryResult* Database::PStreamQuery(const char* format, ...)
+{
+    if (!format) return nullptr;
+
+    va_list ap;
+    char szQuery [MAX_QUERY_LEN];
+    va_start(ap, format);
+    int res = vsnprintf(szQuery, MAX_QUERY_LEN, format, ap);
+    va_end(ap);
+
+    if (res == -1)
+    {
+        sLog.outError("SQL Query truncated (and not execute) for format: %s", format);
+        return nullptr;
+    }
+
+    return StreamQuery(szQuery);
+}
+
+SqlConnection* Database::AcquireStreamConnection()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_streamConnLock);
+        if (!m_pStreamConnections.empty())
+        {
+            SqlConnection* conn = m_pStreamConnections.back();
+            m_pStreamConnections.pop_back();
+            return conn;
+        }
+    }
+
+    SqlConnection* conn = CreateConnection();
+    if (!conn->Initialize(m_infoString.c_str()))
+    {
+        delete conn;
+        return nullptr;
+    }
+
+    return conn;
+}
+
+void Database::ReleaseStreamConnection(SqlConnection* conn)
+{
+    std::lock_guard<std::mutex> guard(m_streamConnLock);
+    m_pStreamConnections.push_back(conn);
+}
+
 QueryNamedResult* Database::PQueryNamed(const char* format, ...)
 {
     if (!format) return nullptr;
@@ -367,6 +513,34 @@ bool Database::PExecute(const char* format, ...)
     return Execute(szQuery);
 }
 
+bool Database::AsyncQuery(MaNGOS::FunctionQueryCallback::Function const& function, const char* sql)
+{
+    if (!sql || !m_threadBody)
+        return false;
+
+    return m_threadBody->Delay(new SqlQuery(sql, new MaNGOS::FunctionQueryCallback(function), nullptr));
+}
+
+bool Database::AsyncPQuery(MaNGOS::FunctionQueryCallback::Function const& function, const char* format, ...)
+{
+    if (!format)
+        return false;
+
+    va_list ap;
+    char szQuery [MAX_QUERY_LEN];
+    va_start(ap, format);
+    int res = vsnprintf(szQuery, MAX_QUERY_LEN, format, ap);
+    va_end(ap);
+
+    if (res == -1)
+    {
+        sLog.outError("SQL Query truncated (and not execute) for format: %s", format);
+        return false;
+    }
+
+    return AsyncQuery(function, szQuery);
+}
+
 bool Database::DirectPExecute(const char* format, ...)
 {
     if (!format)
@@ -582,6 +756,34 @@ bool Database::DirectExecuteStmt(const SqlStatementID& id, SqlStmtParameters* pa
     return result;
 }
 
+QueryResult* Database::QueryStmt(const SqlStatementID& id, SqlStmtParameters* params)
+{
+    MANGOS_ASSERT(params);
+
+    SqlConnection::Lock _guard(getQueryConnection());
+    QueryResult* result = _guard->QueryStmt(id.ID(), *params);
+    delete params;
+    return result;
+}
+
+QueryResult* Database::StreamQueryStmt(const SqlStatementID& id, SqlStmtParameters* params)
+{
+    MANGOS_ASSERT(params);
+
+    QueryResult* result = nullptr;
+    if (SqlConnection* conn = AcquireStreamConnection())
+    {
+        result = conn->QueryStmtStream(id.ID(), *params);
+        if (result)
+            result = new QueryResultStream(result, *this, conn);
+        else
+            ReleaseStreamConnection(conn);
+    }
+
+    delete params;
+    return result;
+}
+
 SqlStatement Database::CreateStatement(SqlStatementID& index, const char* fmt)
 {
     int nId = -1;
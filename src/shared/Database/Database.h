@@ -48,6 +48,9 @@ class SqlConnection
         // public methods for making queries
         virtual QueryResult* Query(const char* sql) = 0;
         virtual QueryNamedResult* QueryNamed(const char* sql) = 0;
+        // unbuffered query, rows are read from the server while the result is walked and
+        // the connection can't run anything else until the result is deleted
+        virtual QueryResult* QueryStream(const char* sql) { return Query(sql); }
 
         // public methods for making requests
         virtual bool Execute(const char* sql) = 0;
@@ -63,6 +66,8 @@ class SqlConnection
 
         // methods to work with prepared statements
         bool ExecuteStmt(int nIndex, const SqlStmtParameters& id);
+        QueryResult* QueryStmt(int nIndex, const SqlStmtParameters& id);
+        QueryResult* QueryStmtStream(int nIndex, const SqlStmtParameters& id);
 
         // SqlConnection object lock
         class Lock
@@ -126,6 +131,15 @@ class Database
         QueryResult* PQuery(const char* format, ...) ATTR_PRINTF(2, 3);
         QueryNamedResult* PQueryNamed(const char* format, ...) ATTR_PRINTF(2, 3);
 
+        /// Synchronous queries for big tables: rows are transferred while the result is read instead of being
+        /// stored in client memory first, so GetRowCount() of the result is 0. Each stream uses a connection of
+        /// its own (opened on demand and kept for later streams), free for other queries only after the result
+        /// is deleted; queries made while walking the result are therefore fine.
+        QueryResult* StreamQuery(const char* sql);
+        QueryResult* PStreamQuery(const char* format, ...) ATTR_PRINTF(2, 3);
+        // row count of a table, e.g. for the progress bar of a streamed load; 0 if the count failed
+        uint32 GetTableRowCount(const char* table);
+
         bool DirectExecute(const char* sql) const
         {
             if (!m_pAsyncConn)
@@ -176,6 +190,9 @@ class Database
         bool DelayQueryHolder(Class* object, void (Class::*method)(QueryResult*, SqlQueryHolder*), SqlQueryHolder* holder);
         template<class Class, typename ParamType1>
         bool DelayQueryHolder(Class* object, void (Class::*method)(QueryResult*, SqlQueryHolder*, ParamType1), SqlQueryHolder* holder, ParamType1 param1);
+        // Query / callable, called from the delay thread and not via ProcessResultQueue(), so it must hand the result over to its owner thread itself
+        bool AsyncQuery(MaNGOS::FunctionQueryCallback::Function const& function, const char* sql);
+        bool AsyncPQuery(MaNGOS::FunctionQueryCallback::Function const& function, const char* format, ...) ATTR_PRINTF(3, 4);
 
         bool Execute(const char* sql);
         bool PExecute(const char* format, ...) ATTR_PRINTF(2, 3);
@@ -251,6 +268,13 @@ class Database
         // query function for prepared statements
         bool ExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params);
         bool DirectExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params);
+        QueryResult* QueryStmt(const SqlStatementID& id, SqlStmtParameters* params);
+        QueryResult* StreamQueryStmt(const SqlStatementID& id, SqlStmtParameters* params);
+
+        // connections for streamed results, nullptr if no connection could be opened
+        SqlConnection* AcquireStreamConnection();
+        void ReleaseStreamConnection(SqlConnection* conn);
+        friend class QueryResultStream;
 
         // connection helper counters
         int m_nQueryConnPoolSize;                           // current size of query connection pool
@@ -263,6 +287,11 @@ class Database
         // only one single DB connection for transactions
         SqlConnection* m_pAsyncConn;
 
+        // idle connections for streamed queries, created on demand
+        std::mutex m_streamConnLock;
+        SqlConnectionContainer m_pStreamConnections;
+        std::string m_infoString;
+
         SqlResultQueue*     m_pResultQueue;                 ///< Transaction queues from diff. threads
         SqlDelayThread*     m_threadBody;                   ///< Pointer to delay sql executer (owned by m_delayThread)
         MaNGOS::Thread*     m_delayThread;                  ///< Pointer to executer thread
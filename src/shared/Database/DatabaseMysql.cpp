@@ -225,6 +225,37 @@ QueryResult* MySQLConnection::Query(const char* sql)
     return queryResult;
 }
 
+QueryResult* MySQLConnection::QueryStream(const char* sql)
+{
+    if (!mMysql)
+        return nullptr;
+
+    uint32 _s = WorldTimer::getMSTime();
+
+    if (mysql_query(mMysql, sql))
+    {
+        sLog.outErrorDb("SQL: %s", sql);
+        sLog.outErrorDb("query ERROR: %s", mysql_error(mMysql));
+        return nullptr;
+    }
+
+    DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL: %s", WorldTimer::getMSTimeDiff(_s, WorldTimer::getMSTime()), sql);
+
+    // rows stay on the server side until they are fetched, the row count is unknown
+    MYSQL_RES* result = mysql_use_result(mMysql);
+    if (!result)
+        return nullptr;
+
+    QueryResultMysql* queryResult = new QueryResultMysql(result, mysql_fetch_fields(result), 0, mysql_field_count(mMysql), mMysql);
+    if (!queryResult->NextRow())
+    {
+        delete queryResult;
+        return nullptr;
+    }
+
+    return queryResult;
+}
+
 QueryNamedResult* MySQLConnection::QueryNamed(const char* sql)
 {
     MYSQL_RES* result = nullptr;
@@ -377,6 +408,7 @@ bool MySqlPreparedStatement::prepare()
         m_nColumns = mysql_num_fields(m_pResultMetadata);
 
         // bind output buffers
+        BindResult();
     }
 
     m_bPrepared = true;
@@ -438,6 +470,51 @@ void MySqlPreparedStatement::addParam(unsigned int nIndex, const SqlStmtFieldDat
     pData.buffer_length = data.type() == FIELD_STRING ? data.size() : 0;
 }
 
+void MySqlPreparedStatement::BindResult()
+{
+    m_pResult = new MYSQL_BIND[m_nColumns];
+    memset(m_pResult, 0, sizeof(MYSQL_BIND) * m_nColumns);
+    m_resultBuffers.resize(m_nColumns);
+
+    MYSQL_FIELD* fields = mysql_fetch_fields(m_pResultMetadata);
+    for (uint32 i = 0; i < m_nColumns; ++i)
+    {
+        MYSQL_BIND& bind = m_pResult[i];
+        ResultBuffer& buffer = m_resultBuffers[i];
+
+        bind.is_null = &buffer.isNull;
+        bind.length = &buffer.length;
+        bind.error = &buffer.error;
+
+        // numbers are converted by the client library, everything else is copied as text;
+        // decimals too, their text keeps the exact value and scale
+        switch (fields[i].type)
+        {
+            case MYSQL_TYPE_TINY:
+            case MYSQL_TYPE_SHORT:
+            case MYSQL_TYPE_LONG:
+            case MYSQL_TYPE_INT24:
+            case MYSQL_TYPE_LONGLONG:
+                bind.buffer_type = MYSQL_TYPE_LONGLONG;
+                bind.is_unsigned = (fields[i].flags & UNSIGNED_FLAG) ? 1 : 0;
+                bind.buffer = &buffer.value.integer;
+                break;
+            case MYSQL_TYPE_FLOAT:
+            case MYSQL_TYPE_DOUBLE:
+                bind.buffer_type = MYSQL_TYPE_DOUBLE;
+                bind.buffer = &buffer.value.real;
+                break;
+            default:
+                // most text columns of the world database are short
+                buffer.text.resize(64);
+                bind.buffer_type = MYSQL_TYPE_STRING;
+                bind.buffer = &buffer.text[0];
+                bind.buffer_length = buffer.text.size();
+                break;
+        }
+    }
+}
+
 void MySqlPreparedStatement::RemoveBinds()
 {
     if (!m_stmt)
@@ -453,6 +530,7 @@ void MySqlPreparedStatement::RemoveBinds()
     m_pResultMetadata = nullptr;
     m_pResult = nullptr;
     m_pInputArgs = nullptr;
+    m_resultBuffers.clear();
 
     m_bPrepared = false;
 }
@@ -472,6 +550,128 @@ bool MySqlPreparedStatement::execute()
     return true;
 }
 
+QueryResultMysqlStmt* MySqlPreparedStatement::ExecuteQuery(bool stream)
+{
+    if (!isPrepared() || !isQuery())
+        return nullptr;
+
+    if (mysql_stmt_execute(m_stmt))
+    {
+        sLog.outError("SQL: cannot execute '%s'", m_szFmt.c_str());
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+        return nullptr;
+    }
+
+    if (mysql_stmt_bind_result(m_stmt, m_pResult))
+    {
+        sLog.outError("SQL ERROR: mysql_stmt_bind_result() failed for '%s'", m_szFmt.c_str());
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+        mysql_stmt_free_result(m_stmt);
+        return nullptr;
+    }
+
+    return new QueryResultMysqlStmt(mysql_fetch_fields(m_pResultMetadata), m_nColumns, stream ? this : nullptr);
+}
+
+QueryResult* MySqlPreparedStatement::query()
+{
+    QueryResultMysqlStmt* result = ExecuteQuery(false);
+    if (!result)
+        return nullptr;
+
+    // rows are copied out while they are fetched, so the statement is free for reuse when we return
+    while (FetchRow(*result)) {}
+
+    result->FinishRows();
+    if (!result->GetRowCount())
+    {
+        delete result;
+        return nullptr;
+    }
+
+    result->NextRow();
+    return result;
+}
+
+QueryResult* MySqlPreparedStatement::queryStream()
+{
+    QueryResultMysqlStmt* result = ExecuteQuery(true);
+    if (!result)
+        return nullptr;
+
+    if (!result->NextRow())
+    {
+        delete result;
+        return nullptr;
+    }
+
+    return result;
+}
+
+bool MySqlPreparedStatement::FetchRow(QueryResultMysqlStmt& result)
+{
+    int status = mysql_stmt_fetch(m_stmt);
+    if (status != 0 && status != MYSQL_DATA_TRUNCATED)
+    {
+        if (status != MYSQL_NO_DATA)
+        {
+            sLog.outError("SQL: cannot fetch result of '%s'", m_szFmt.c_str());
+            if (result.IsStreamed())
+                QueryResultMysql::StreamFetchFailed(mysql_stmt_error(m_stmt));
+
+            sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+        }
+
+        mysql_stmt_free_result(m_stmt);
+        return false;
+    }
+
+    bool rebind = false;
+    for (uint32 i = 0; i < m_nColumns; ++i)
+    {
+        MYSQL_BIND& bind = m_pResult[i];
+        ResultBuffer& buffer = m_resultBuffers[i];
+
+        if (buffer.isNull)
+        {
+            result.AddNull();
+            continue;
+        }
+
+        switch (bind.buffer_type)
+        {
+            case MYSQL_TYPE_LONGLONG:
+                result.AddInteger(buffer.value.integer);
+                break;
+            case MYSQL_TYPE_DOUBLE:
+                result.AddFloat(buffer.value.real);
+                break;
+            default:
+                if (buffer.length > bind.buffer_length)
+                {
+                    // grow the buffer and fetch the whole value again, it stays bigger for later rows
+                    buffer.text.resize(buffer.length);
+                    bind.buffer = &buffer.text[0];
+                    bind.buffer_length = buffer.text.size();
+                    mysql_stmt_fetch_column(m_stmt, &bind, i, 0);
+                    rebind = true;
+                }
+                result.AddString(&buffer.text[0], buffer.length);
+                break;
+        }
+    }
+
+    if (rebind)
+        mysql_stmt_bind_result(m_stmt, m_pResult);
+
+    return true;
+}
+
+void MySqlPreparedStatement::FreeResult()
+{
+    mysql_stmt_free_result(m_stmt);
+}
+
 enum_field_types MySqlPreparedStatement::ToMySQLType(const SqlStmtFieldData& data, my_bool& bUnsigned)
 {
     bUnsigned = 0;
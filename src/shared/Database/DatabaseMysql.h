@@ -47,6 +47,15 @@ class MySqlPreparedStatement : public SqlPreparedStatement
         // execute DML statement
         virtual bool execute() override;
 
+        // execute query statement and fetch its rows in binary protocol
+        virtual QueryResult* query() override;
+        virtual QueryResult* queryStream() override;
+
+        // append the next row of the current result set, false (and the result set freed) at its end
+        bool FetchRow(QueryResultMysqlStmt& result);
+        // drop the rest of a result set which is not read to its end
+        void FreeResult();
+
     protected:
         // bind parameters
         void addParam(unsigned int nIndex, const SqlStmtFieldData& data);
@@ -54,13 +63,32 @@ class MySqlPreparedStatement : public SqlPreparedStatement
         static enum_field_types ToMySQLType(const SqlStmtFieldData& data, my_bool& bUnsigned);
 
     private:
+        // output buffer of one result column
+        struct ResultBuffer
+        {
+            ResultBuffer() : length(0), isNull(0), error(0) { value.integer = 0; }
+
+            union
+            {
+                int64 integer;
+                double real;
+            } value;
+            std::vector<char> text;                         // string columns, grown on demand
+            unsigned long length;
+            my_bool isNull;
+            my_bool error;
+        };
+
+        void BindResult();
         void RemoveBinds();
+        QueryResultMysqlStmt* ExecuteQuery(bool stream);
 
         MYSQL* m_pMySQLConn;
         MYSQL_STMT* m_stmt;
         MYSQL_BIND* m_pInputArgs;
         MYSQL_BIND* m_pResult;
         MYSQL_RES* m_pResultMetadata;
+        std::vector<ResultBuffer> m_resultBuffers;
 };
 
 class MySQLConnection : public SqlConnection
@@ -74,6 +102,7 @@ class MySQLConnection : public SqlConnection
         bool Initialize(const char* infoString) override;
 
         QueryResult* Query(const char* sql) override;
+        QueryResult* QueryStream(const char* sql) override;
         QueryNamedResult* QueryNamed(const char* sql) override;
         bool Execute(const char* sql) override;
 
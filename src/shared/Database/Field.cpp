@@ -16,5 +16,20 @@
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
-//#include "DatabaseEnv.h"
+#include "DatabaseEnv.h"
 
+#include <cfloat>
+
+void Field::FormatBinaryValue() const
+{
+    // mValue is the buffer handed to SetBinaryValue()
+    char* text = const_cast<char*>(mValue);
+
+    switch (mBinary)
+    {
+        case BINARY_FLOAT:      snprintf(text, BinaryTextSize, "%.*g", FLT_DIG, mBinaryValue.d);                    break;
+        case BINARY_DOUBLE:     snprintf(text, BinaryTextSize, "%.*g", DBL_DIG, mBinaryValue.d);                    break;
+        case BINARY_UNSIGNED:   snprintf(text, BinaryTextSize, UI64FMTD, static_cast<uint64>(mBinaryValue.i64));    break;
+        default:                snprintf(text, BinaryTextSize, SI64FMTD, mBinaryValue.i64);                         break;
+    }
+}
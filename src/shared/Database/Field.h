@@ -34,28 +34,38 @@ class Field
             DB_TYPE_BOOL    = 0x04
         };
 
-        Field() : mValue(nullptr), mType(DB_TYPE_UNKNOWN) {}
-        Field(const char* value, enum DataTypes type) : mValue(value), mType(type) {}
+        Field() : mValue(nullptr), mType(DB_TYPE_UNKNOWN), mBinary(BINARY_NONE) { mBinaryValue.i64 = 0; }
+        Field(const char* value, enum DataTypes type) : mValue(value), mType(type), mBinary(BINARY_NONE) { mBinaryValue.i64 = 0; }
 
         ~Field() {}
 
         enum DataTypes GetType() const { return mType; }
         bool IsNULL() const { return mValue == nullptr; }
 
-        const char* GetString() const { return mValue; }
+        const char* GetString() const
+        {
+            if (mBinary && mValue)
+                FormatBinaryValue();
+
+            return mValue;
+        }
         std::string GetCppString() const
         {
-            return mValue ? mValue : "";                    // std::string s = 0 have undefine result in C++
+            const char* value = GetString();
+            return value ? value : "";                      // std::string s = 0 have undefine result in C++
         }
-        float GetFloat() const { return mValue ? static_cast<float>(atof(mValue)) : 0.0f; }
-        bool GetBool() const { return mValue ? atoi(mValue) > 0 : false; }
-        int32 GetInt32() const { return mValue ? static_cast<int32>(atol(mValue)) : int32(0); }
-        uint8 GetUInt8() const { return mValue ? static_cast<uint8>(atol(mValue)) : uint8(0); }
-        uint16 GetUInt16() const { return mValue ? static_cast<uint16>(atol(mValue)) : uint16(0); }
-        int16 GetInt16() const { return mValue ? static_cast<int16>(atol(mValue)) : int16(0); }
-        uint32 GetUInt32() const { return mValue ? static_cast<uint32>(atoll(mValue)) : uint32(0); }
+        float GetFloat() const { return mBinary ? static_cast<float>(GetBinaryDouble()) : mValue ? static_cast<float>(atof(mValue)) : 0.0f; }
+        bool GetBool() const { return mBinary ? (mBinary == BINARY_UNSIGNED ? GetBinaryInt() != 0 : GetBinaryInt() > 0) : mValue ? atoi(mValue) > 0 : false; }
+        int32 GetInt32() const { return mBinary ? static_cast<int32>(GetBinaryInt()) : mValue ? static_cast<int32>(atol(mValue)) : int32(0); }
+        uint8 GetUInt8() const { return mBinary ? static_cast<uint8>(GetBinaryInt()) : mValue ? static_cast<uint8>(atol(mValue)) : uint8(0); }
+        uint16 GetUInt16() const { return mBinary ? static_cast<uint16>(GetBinaryInt()) : mValue ? static_cast<uint16>(atol(mValue)) : uint16(0); }
+        int16 GetInt16() const { return mBinary ? static_cast<int16>(GetBinaryInt()) : mValue ? static_cast<int16>(atol(mValue)) : int16(0); }
+        uint32 GetUInt32() const { return mBinary ? static_cast<uint32>(GetBinaryInt()) : mValue ? static_cast<uint32>(atoll(mValue)) : uint32(0); }
         uint64 GetUInt64() const
         {
+            if (mBinary)
+                return static_cast<uint64>(GetBinaryInt());
+
             uint64 value = 0;
             if (!mValue || sscanf(mValue, UI64FMTD, &value) == -1)
                 return 0;
@@ -66,13 +76,54 @@ class Field
         void SetType(enum DataTypes type) { mType = type; }
         // no need for memory allocations to store resultset field strings
         // all we need is to cache pointers returned by different DBMS APIs
-        void SetValue(const char* value) { mValue = value; };
+        void SetValue(const char* value) { mValue = value; mBinary = BINARY_NONE; }
+        enum BinaryKind
+        {
+            BINARY_NONE     = 0x00,                         // mValue is text
+            BINARY_INTEGER  = 0x01,                         // mBinaryValue.i64
+            BINARY_UNSIGNED = 0x02,                         // mBinaryValue.i64 holding an uint64
+            BINARY_FLOAT    = 0x03,                         // mBinaryValue.d of a FLOAT column
+            BINARY_DOUBLE   = 0x04                          // mBinaryValue.d of a DOUBLE column
+        };
+
+        // size of the text buffer the result set provides for each binary value
+        static const size_t BinaryTextSize = 32;
+
+        // numeric values of binary protocol result sets, no conversion from text needed; text is a buffer
+        // of BinaryTextSize chars owned by the result set, GetString() writes the value there on request
+        void SetBinaryValue(int64 value, BinaryKind kind, char* text) { mBinaryValue.i64 = value; mValue = text; mBinary = kind; }
+        void SetBinaryValue(double value, BinaryKind kind, char* text) { mBinaryValue.d = value; mValue = text; mBinary = kind; }
 
     private:
         Field(Field const&);
         Field& operator=(Field const&);
 
-        const char* mValue;
+        bool IsBinaryFloat() const { return mBinary == BINARY_FLOAT || mBinary == BINARY_DOUBLE; }
+
+        int64 GetBinaryInt() const { return mValue ? (IsBinaryFloat() ? static_cast<int64>(mBinaryValue.d) : mBinaryValue.i64) : 0; }
+        double GetBinaryDouble() const
+        {
+            if (!mValue)
+                return 0.0;
+
+            switch (mBinary)
+            {
+                case BINARY_UNSIGNED: return static_cast<double>(static_cast<uint64>(mBinaryValue.i64));
+                case BINARY_INTEGER:  return static_cast<double>(mBinaryValue.i64);
+                default:              return mBinaryValue.d;
+            }
+        }
+
+        // text of a binary value for GetString(), as the text protocol would have sent it
+        void FormatBinaryValue() const;
+
+        const char* mValue;                                 // text value, or the text buffer of a binary value; nullptr for NULL
         enum DataTypes mType;
+        enum BinaryKind mBinary;
+        union
+        {
+            int64 i64;
+            double d;
+        } mBinaryValue;
 };
 #endif
@@ -21,8 +21,8 @@
 #include "DatabaseEnv.h"
 #include "Errors.h"
 
-QueryResultMysql::QueryResultMysql(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount) :
-    QueryResult(rowCount, fieldCount), mResult(result)
+QueryResultMysql::QueryResultMysql(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount, MYSQL* streamConn) :
+    QueryResult(rowCount, fieldCount), mResult(result), mStreamConn(streamConn)
 {
     mCurrentRow = new Field[mFieldCount];
     MANGOS_ASSERT(mCurrentRow);
@@ -46,6 +46,10 @@ bool QueryResultMysql::NextRow()
     row = mysql_fetch_row(mResult);
     if (!row)
     {
+        // for a streamed result no row can also mean the connection failed
+        if (mStreamConn && mysql_errno(mStreamConn))
+            StreamFetchFailed(mysql_error(mStreamConn));
+
         EndQuery();
         return false;
     }
@@ -56,6 +60,14 @@ bool QueryResultMysql::NextRow()
     return true;
 }
 
+void QueryResultMysql::StreamFetchFailed(char const* error)
+{
+    sLog.outError("SQL: fetching the rows of a streamed query failed, the loaded data would be incomplete");
+    sLog.outError("SQL ERROR: %s", error);
+    Log::WaitBeforeContinueIfNeed();
+    exit(1);
+}
+
 void QueryResultMysql::EndQuery()
 {
     delete[] mCurrentRow;
@@ -68,7 +80,7 @@ void QueryResultMysql::EndQuery()
     }
 }
 
-enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType) const
+enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType)
 {
     switch (mysqlType)
     {
@@ -98,4 +110,82 @@ enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysql
             return Field::DB_TYPE_UNKNOWN;
     }
 }
+
+QueryResultMysqlStmt::QueryResultMysqlStmt(MYSQL_FIELD* fields, uint32 fieldCount, MySqlPreparedStatement* stmt) :
+    QueryResult(0, fieldCount), mNextCell(0), mStream(stmt)
+{
+    mCurrentRow = new Field[mFieldCount];
+    MANGOS_ASSERT(mCurrentRow);
+
+    mBinaryKinds.resize(mFieldCount, Field::BINARY_INTEGER);
+    mBinaryTexts.resize(mFieldCount * Field::BinaryTextSize);
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        mCurrentRow[i].SetType(QueryResultMysql::ConvertNativeType(fields[i].type));
+
+        // GetString() of numbers has to match the text protocol, which depends on the column type
+        switch (fields[i].type)
+        {
+            case MYSQL_TYPE_FLOAT:  mBinaryKinds[i] = Field::BINARY_FLOAT;  break;
+            case MYSQL_TYPE_DOUBLE: mBinaryKinds[i] = Field::BINARY_DOUBLE; break;
+            default:
+                if (fields[i].flags & UNSIGNED_FLAG)
+                    mBinaryKinds[i] = Field::BINARY_UNSIGNED;
+                break;
+        }
+    }
+}
+
+QueryResultMysqlStmt::~QueryResultMysqlStmt()
+{
+    if (mStream)
+        mStream->FreeResult();
+
+    delete[] mCurrentRow;
+}
+
+void QueryResultMysqlStmt::AddString(const char* value, size_t length)
+{
+    Cell cell(CELL_STRING);
+    cell.offset = mStrings.size();
+    mCells.push_back(cell);
+
+    mStrings.insert(mStrings.end(), value, value + length);
+    mStrings.push_back('\0');
+}
+
+bool QueryResultMysqlStmt::NextRow()
+{
+    if (mStream)
+    {
+        // the previous row is not referenced anymore, reuse its storage
+        mCells.clear();
+        mStrings.clear();
+        mNextCell = 0;
+
+        if (!mStream->FetchRow(*this))
+        {
+            mStream = nullptr;
+            return false;
+        }
+    }
+
+    if (mNextCell + mFieldCount > mCells.size())
+        return false;
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        Cell const& cell = mCells[mNextCell++];
+        switch (cell.kind)
+        {
+            case CELL_NULL:     mCurrentRow[i].SetValue(nullptr);                   break;
+            case CELL_INTEGER:  mCurrentRow[i].SetBinaryValue(cell.integer, mBinaryKinds[i], &mBinaryTexts[i * Field::BinaryTextSize]); break;
+            case CELL_FLOAT:    mCurrentRow[i].SetBinaryValue(cell.real, mBinaryKinds[i], &mBinaryTexts[i * Field::BinaryTextSize]);    break;
+            case CELL_STRING:   mCurrentRow[i].SetValue(&mStrings[cell.offset]);    break;
+        }
+    }
+
+    return true;
+}
 #endif
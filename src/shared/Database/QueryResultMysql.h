@@ -33,17 +33,78 @@
 class QueryResultMysql : public QueryResult
 {
     public:
-        QueryResultMysql(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount);
+        // streamConn is the connection of a mysql_use_result() result, rows are fetched from it in NextRow()
+        QueryResultMysql(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount, MYSQL* streamConn = nullptr);
 
         ~QueryResultMysql();
 
         bool NextRow() override;
 
+        static enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType);
+
+        // a streamed result which broke off would look like a complete but shorter table, stop the server instead
+        static void StreamFetchFailed(char const* error);
+
     private:
-        enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType) const;
         void EndQuery();
 
         MYSQL_RES* mResult;
+        MYSQL* mStreamConn;
+};
+
+class MySqlPreparedStatement;
+
+// result set of a prepared statement query, fetched in binary protocol;
+// numeric columns are kept as numbers so reading a field needs no text conversion.
+// A streamed result only keeps the current row and fetches the next one from stmt in NextRow()
+class QueryResultMysqlStmt : public QueryResult
+{
+    public:
+        QueryResultMysqlStmt(MYSQL_FIELD* fields, uint32 fieldCount, MySqlPreparedStatement* stmt);
+
+        ~QueryResultMysqlStmt();
+
+        bool NextRow() override;
+
+        bool IsStreamed() const { return mStream != nullptr; }
+
+        // append the columns of a fetched row, in column order
+        void AddNull() { mCells.push_back(Cell(CELL_NULL)); }
+        void AddInteger(int64 value) { Cell cell(CELL_INTEGER); cell.integer = value; mCells.push_back(cell); }
+        void AddFloat(double value) { Cell cell(CELL_FLOAT); cell.real = value; mCells.push_back(cell); }
+        void AddString(const char* value, size_t length);
+
+        // must be called after the last row was added
+        void FinishRows() { mRowCount = mFieldCount ? mCells.size() / mFieldCount : 0; }
+
+    private:
+        enum CellKind
+        {
+            CELL_NULL,
+            CELL_INTEGER,
+            CELL_FLOAT,
+            CELL_STRING
+        };
+
+        struct Cell
+        {
+            explicit Cell(CellKind kind) : kind(kind), integer(0) {}
+
+            CellKind kind;
+            union
+            {
+                int64 integer;
+                double real;
+                size_t offset;                              // of the null terminated value in mStrings
+            };
+        };
+
+        std::vector<Cell> mCells;
+        std::vector<char> mStrings;
+        std::vector<Field::BinaryKind> mBinaryKinds;        // of each column, for its text
+        std::vector<char> mBinaryTexts;                     // text buffer of each column for Field::GetString()
+        size_t mNextCell;
+        MySqlPreparedStatement* mStream;                    // statement with the unread rest of a streamed result
 };
 #endif
 #endif
@@ -17,6 +17,10 @@
  */
 
 #include "SQLStorage.h"
+#include "Log.h"
+
+#include <cstdio>
+#include <cerrno>
 
 // -----------------------------------  SQLStorageBase  ---------------------------------------- //
 
@@ -238,3 +242,212 @@ SQLMultiStorage::SQLMultiStorage(const char* src_fmt, const char* dst_fmt, const
 {
     Initialize(sqlname, _entry_field, src_fmt, dst_fmt);
 }
+
+// -----------------------------------  SQLStorageSnapshot  ------------------------------------ //
+
+#define SQL_STORAGE_SNAPSHOT_MAGIC      0x534C5153          // "SQLS"
+#define SQL_STORAGE_SNAPSHOT_VERSION    1
+#define SQL_STORAGE_SNAPSHOT_NULL       0xFFFFFFFF          // string length of NULL values
+
+std::string SQLStorageSnapshot::m_directory;
+
+static uint64 SnapshotHash(char const* data, size_t size)
+{
+    // FNV-1a
+    uint64 hash = uint64(0xcbf29ce484222325ULL);
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= uint8(data[i]);
+        hash *= uint64(0x100000001b3ULL);
+    }
+    return hash;
+}
+
+void SQLStorageSnapshot::SetDirectory(std::string const& dir)
+{
+    m_directory = dir;
+    if (!m_directory.empty() && m_directory[m_directory.size() - 1] != '/' && m_directory[m_directory.size() - 1] != '\\')
+        m_directory += '/';
+}
+
+SQLStorageSnapshot::SQLStorageSnapshot(SQLStorageBase const& store) :
+    m_enabled(false), m_tableChecksum(0), m_maxRecordId(0), m_recordCount(0), m_readPos(0), m_readError(false)
+{
+    if (m_directory.empty())
+        return;
+
+    QueryResult* result = WorldDatabase.PQuery("CHECKSUM TABLE %s", store.GetTableName());
+    if (!result)
+        return;
+
+    // NULL if the table does not exist or the engine can not report a checksum
+    Field* fields = result->Fetch();
+    if (!fields[1].IsNULL())
+    {
+        m_enabled = true;
+        m_tableChecksum = fields[1].GetUInt64();
+        m_fileName = m_directory + store.GetTableName() + ".snapshot";
+        m_format = store.GetSrcFormat();
+    }
+    delete result;
+}
+
+bool SQLStorageSnapshot::Read(void* value, size_t size)
+{
+    if (m_readError || m_readPos + size > m_data.size())
+    {
+        m_readError = true;
+        return false;
+    }
+
+    memcpy(value, &m_data[m_readPos], size);
+    m_readPos += size;
+    return true;
+}
+
+uint32 SQLStorageSnapshot::ReadUInt32()
+{
+    uint32 value = 0;
+    Read(&value, sizeof(value));
+    return value;
+}
+
+uint64 SQLStorageSnapshot::ReadUInt64()
+{
+    uint64 value = 0;
+    Read(&value, sizeof(value));
+    return value;
+}
+
+float SQLStorageSnapshot::ReadFloat()
+{
+    float value = 0.0f;
+    Read(&value, sizeof(value));
+    return value;
+}
+
+char const* SQLStorageSnapshot::ReadString()
+{
+    uint32 length = ReadUInt32();
+    if (m_readError || length == SQL_STORAGE_SNAPSHOT_NULL)
+        return nullptr;
+
+    // value is stored with its terminator
+    if (m_readPos + length + 1 > m_data.size() || m_data[m_readPos + length] != '\0')
+    {
+        m_readError = true;
+        return nullptr;
+    }
+
+    char const* value = &m_data[m_readPos];
+    m_readPos += length + 1;
+    return value;
+}
+
+void SQLStorageSnapshot::AddString(char const* value)
+{
+    if (!value)
+    {
+        AddUInt32(SQL_STORAGE_SNAPSHOT_NULL);
+        return;
+    }
+
+    uint32 length = strlen(value);
+    AddUInt32(length);
+    Append(value, length + 1);
+}
+
+bool SQLStorageSnapshot::Load()
+{
+    FILE* file = fopen(m_fileName.c_str(), "rb");
+    if (!file)
+        return false;
+
+    // one read for the whole file, the rows are parsed from memory
+    fseek(file, 0, SEEK_END);
+    long fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    m_data.resize(fileSize > 0 ? fileSize : 0);
+    bool ok = fileSize > 0 && fread(&m_data[0], 1, m_data.size(), file) == m_data.size();
+    fclose(file);
+
+    m_readPos = 0;
+    m_readError = !ok;
+
+    uint32 magic = ReadUInt32();
+    uint32 version = ReadUInt32();
+    uint64 tableChecksum = ReadUInt64();
+    uint32 formatLength = ReadUInt32();
+    std::string format;
+    if (!m_readError && formatLength <= m_data.size() - m_readPos)
+    {
+        format.assign(&m_data[m_readPos], formatLength);
+        m_readPos += formatLength;
+    }
+    m_maxRecordId = ReadUInt32();
+    m_recordCount = ReadUInt32();
+    uint64 dataSize = ReadUInt64();
+    uint64 dataHash = ReadUInt64();
+
+    if (m_readError || magic != SQL_STORAGE_SNAPSHOT_MAGIC || version != SQL_STORAGE_SNAPSHOT_VERSION)
+    {
+        sLog.outError("Snapshot file %s is damaged or from another version, ignored", m_fileName.c_str());
+        m_data.clear();
+        return false;
+    }
+
+    // table content or structure changed since the snapshot was written
+    if (tableChecksum != m_tableChecksum || format != m_format)
+    {
+        m_data.clear();
+        return false;
+    }
+
+    if (dataSize != m_data.size() - m_readPos || SnapshotHash(&m_data[0] + m_readPos, m_data.size() - m_readPos) != dataHash)
+    {
+        sLog.outError("Snapshot file %s is damaged, ignored", m_fileName.c_str());
+        m_data.clear();
+        return false;
+    }
+
+    return true;
+}
+
+void SQLStorageSnapshot::Save(uint32 maxRecordId, uint32 recordCount)
+{
+    std::string tmpFileName = m_fileName + ".tmp";
+    FILE* file = fopen(tmpFileName.c_str(), "wb");
+    if (!file)
+    {
+        sLog.outError("Can not create snapshot file %s", tmpFileName.c_str());
+        return;
+    }
+
+    uint32 magic = SQL_STORAGE_SNAPSHOT_MAGIC;
+    uint32 version = SQL_STORAGE_SNAPSHOT_VERSION;
+    uint32 formatLength = m_format.size();
+    uint64 dataSize = m_data.size();
+    uint64 dataHash = SnapshotHash(m_data.empty() ? nullptr : &m_data[0], m_data.size());
+
+    bool ok = fwrite(&magic, sizeof(magic), 1, file) == 1 &&
+              fwrite(&version, sizeof(version), 1, file) == 1 &&
+              fwrite(&m_tableChecksum, sizeof(m_tableChecksum), 1, file) == 1 &&
+              fwrite(&formatLength, sizeof(formatLength), 1, file) == 1 &&
+              fwrite(m_format.c_str(), 1, formatLength, file) == formatLength &&
+              fwrite(&maxRecordId, sizeof(maxRecordId), 1, file) == 1 &&
+              fwrite(&recordCount, sizeof(recordCount), 1, file) == 1 &&
+              fwrite(&dataSize, sizeof(dataSize), 1, file) == 1 &&
+              fwrite(&dataHash, sizeof(dataHash), 1, file) == 1 &&
+              (m_data.empty() || fwrite(&m_data[0], 1, m_data.size(), file) == m_data.size());
+    ok = fclose(file) == 0 && ok;
+
+    // replace the old snapshot only with a completely written one
+    if (!ok || (remove(m_fileName.c_str()) != 0 && errno != ENOENT) || rename(tmpFileName.c_str(), m_fileName.c_str()) != 0)
+    {
+        sLog.outError("Can not write snapshot file %s", m_fileName.c_str());
+        remove(tmpFileName.c_str());
+    }
+
+    m_data.clear();
+}
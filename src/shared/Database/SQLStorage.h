@@ -244,6 +244,66 @@ class SQLMultiStorage : public SQLStorageBase
         RecordMultiMap m_indexMultiMap;
 };
 
+/**
+ * Binary copy of the rows loaded into a SQL storage, kept on disk to skip the query and the
+ * text parsing at the next startup.
+ *
+ * A snapshot stores the record id and the source values of every row, so the loader still
+ * converts them like rows read from the database. It is only used while the checksum the
+ * database reports for the table (CHECKSUM TABLE) and the source format are unchanged, and
+ * its content is verified with a hash; any mismatch or read error makes the caller load the
+ * table from the database again, which then writes a new snapshot.
+ */
+class SQLStorageSnapshot
+{
+    public:
+        // enables snapshots, stored in dir; an empty dir disables them
+        static void SetDirectory(std::string const& dir);
+
+        // does nothing if snapshots are disabled or the table checksum is not available
+        explicit SQLStorageSnapshot(SQLStorageBase const& store);
+
+        bool IsEnabled() const { return m_enabled; }
+
+        // read the snapshot file, false if there is none or it is stale or damaged
+        bool Load();
+        uint32 GetMaxRecordId() const { return m_maxRecordId; }
+        uint32 GetRecordCount() const { return m_recordCount; }
+
+        // sequential access to the values of a loaded snapshot, in the order they were added
+        uint32 ReadUInt32();
+        uint64 ReadUInt64();
+        float ReadFloat();
+        char const* ReadString();                           // nullptr for NULL values
+        bool HasReadError() const { return m_readError; }
+
+        // record the values of rows loaded from the database, in the order they are read
+        void AddUInt32(uint32 value) { Append(&value, sizeof(value)); }
+        void AddUInt64(uint64 value) { Append(&value, sizeof(value)); }
+        void AddFloat(float value) { Append(&value, sizeof(value)); }
+        void AddString(char const* value);
+
+        // write the recorded rows, replacing an older snapshot
+        void Save(uint32 maxRecordId, uint32 recordCount);
+
+    private:
+        void Append(void const* value, size_t size) { m_data.insert(m_data.end(), (char const*)value, (char const*)value + size); }
+        bool Read(void* value, size_t size);
+
+        static std::string m_directory;
+
+        bool m_enabled;
+        std::string m_fileName;
+        std::string m_format;
+        uint64 m_tableChecksum;
+        uint32 m_maxRecordId;
+        uint32 m_recordCount;
+
+        std::vector<char> m_data;                           // row values
+        size_t m_readPos;
+        bool m_readError;
+};
+
 template <class DerivedLoader, class StorageClass>
 class SQLStorageLoaderBase
 {
@@ -270,6 +330,42 @@ class SQLStorageLoaderBase
         void convert_str_to_str(uint32 field_pos, char* src, char*& dst);
 
     private:
+        // source values of a row read from the database, optionally recorded for a snapshot
+        class FieldReader
+        {
+            public:
+                FieldReader(Field* fields, SQLStorageSnapshot* snapshot) : m_fields(fields), m_snapshot(snapshot) {}
+
+                uint32 GetUInt32(uint32 idx) const { uint32 value = m_fields[idx].GetUInt32(); if (m_snapshot) m_snapshot->AddUInt32(value); return value; }
+                uint64 GetUInt64(uint32 idx) const { uint64 value = m_fields[idx].GetUInt64(); if (m_snapshot) m_snapshot->AddUInt64(value); return value; }
+                float GetFloat(uint32 idx) const { float value = m_fields[idx].GetFloat(); if (m_snapshot) m_snapshot->AddFloat(value); return value; }
+                char const* GetString(uint32 idx) const { char const* value = m_fields[idx].GetString(); if (m_snapshot) m_snapshot->AddString(value); return value; }
+
+            private:
+                Field* m_fields;
+                SQLStorageSnapshot* m_snapshot;
+        };
+
+        // source values of a row read from a snapshot
+        class SnapshotReader
+        {
+            public:
+                explicit SnapshotReader(SQLStorageSnapshot& snapshot) : m_snapshot(snapshot) {}
+
+                uint32 GetUInt32(uint32 /*idx*/) const { return m_snapshot.ReadUInt32(); }
+                uint64 GetUInt64(uint32 /*idx*/) const { return m_snapshot.ReadUInt64(); }
+                float GetFloat(uint32 /*idx*/) const { return m_snapshot.ReadFloat(); }
+                char const* GetString(uint32 /*idx*/) const { return m_snapshot.ReadString(); }
+
+            private:
+                SQLStorageSnapshot& m_snapshot;
+        };
+
+        uint32 GetRecordSize(StorageClass& store) const;
+        template<class RowReader>
+        void LoadRecord(StorageClass& store, RowReader const& row);
+        bool LoadSnapshot(StorageClass& store, SQLStorageSnapshot& snapshot);
+
         template<class V>
         void storeValue(V value, StorageClass& store, char* record, uint32 field_pos, uint32& offset);
         void storeValue(char const* value, StorageClass& store, char* record, uint32 field_pos, uint32& offset);
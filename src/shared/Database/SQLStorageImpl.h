@@ -189,7 +189,10 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::storeValue(char const* v
 template<class DerivedLoader, class StorageClass>
 void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store, bool error_at_empty /*= true*/)
 {
-    Field* fields = nullptr;
+    SQLStorageSnapshot snapshot(store);
+    if (snapshot.IsEnabled() && LoadSnapshot(store, snapshot))
+        return;
+
     QueryResult* result  = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s", store.EntryFieldName(), store.GetTableName());
     if (!result)
     {
@@ -199,19 +202,11 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
     }
 
     uint32 maxRecordId = (*result)[0].GetUInt32() + 1;
-    uint32 recordCount = 0;
-    uint32 recordsize = 0;
+    uint32 recordCount = WorldDatabase.GetTableRowCount(store.GetTableName());
     delete result;
 
-    result = WorldDatabase.PQuery("SELECT COUNT(*) FROM %s", store.GetTableName());
-    if (result)
-    {
-        fields = result->Fetch();
-        recordCount = fields[0].GetUInt32();
-        delete result;
-    }
-
-    result = WorldDatabase.PQuery("SELECT * FROM %s", store.GetTableName());
+    // rows are stored right away, no need to keep the whole table in client memory
+    result = WorldDatabase.PStreamQuery("SELECT * FROM %s", store.GetTableName());
 
     if (!result)
     {
@@ -233,8 +228,57 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         exit(1);                                            // Stop server at loading broken or non-compatible table.
     }
 
-    // get struct size
-    uint32 offset = 0;
+    // Prepare data storage and lookup storage
+    store.prepareToLoad(maxRecordId, recordCount, GetRecordSize(store));
+
+    BarGoLink bar(recordCount);
+    uint32 loadedRecords = 0;
+    do
+    {
+        bar.step();
+        LoadRecord(store, FieldReader(result->Fetch(), snapshot.IsEnabled() ? &snapshot : nullptr));
+        ++loadedRecords;
+    }
+    while (result->NextRow());
+
+    delete result;
+
+    if (snapshot.IsEnabled())
+        snapshot.Save(maxRecordId, loadedRecords);
+}
+
+template<class DerivedLoader, class StorageClass>
+bool SQLStorageLoaderBase<DerivedLoader, StorageClass>::LoadSnapshot(StorageClass& store, SQLStorageSnapshot& snapshot)
+{
+    if (!snapshot.Load())
+        return false;
+
+    store.prepareToLoad(snapshot.GetMaxRecordId(), snapshot.GetRecordCount(), GetRecordSize(store));
+
+    BarGoLink bar(snapshot.GetRecordCount());
+    SnapshotReader reader(snapshot);
+    for (uint32 i = 0; i < snapshot.GetRecordCount() && !snapshot.HasReadError(); ++i)
+    {
+        bar.step();
+        LoadRecord(store, reader);
+    }
+
+    if (snapshot.HasReadError())
+    {
+        // should not happen after the hash check, start over from the database
+        sLog.outError("Snapshot of %s table is damaged, loading from database", store.GetTableName());
+        store.prepareToLoad(0, 0, GetRecordSize(store));
+        return false;
+    }
+
+    sLog.outString("%s table loaded from snapshot", store.GetTableName());
+    return true;
+}
+
+template<class DerivedLoader, class StorageClass>
+uint32 SQLStorageLoaderBase<DerivedLoader, StorageClass>::GetRecordSize(StorageClass& store) const
+{
+    uint32 recordsize = 0;
     for (uint32 x = 0; x < store.GetDstFieldCount(); ++x)
     {
         switch (store.GetDstFormat(x))
@@ -269,66 +313,60 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         }
     }
 
-    // Prepare data storage and lookup storage
-    store.prepareToLoad(maxRecordId, recordCount, recordsize);
+    return recordsize;
+}
 
-    BarGoLink bar(recordCount);
-    do
+template<class DerivedLoader, class StorageClass>
+template<class RowReader>
+void SQLStorageLoaderBase<DerivedLoader, StorageClass>::LoadRecord(StorageClass& store, RowReader const& row)
+{
+    char* record = store.createRecord(row.GetUInt32(0));
+    uint32 offset = 0;
+
+    // dependend on dest-size
+    // iterate two indexes: x over dest, y over source
+    //                      y++ If and only If x != FT_NA*
+    //                      x++ If and only If a value is stored
+    for (uint32 x = 0, y = 0; x < store.GetDstFieldCount();)
     {
-        fields = result->Fetch();
-        bar.step();
+        switch (store.GetDstFormat(x))
+        {
+            // For default fill continue and do not increase y
+            case FT_NA:         storeValue((uint32)0, store, record, x, offset);         ++x; continue;
+            case FT_NA_BYTE:    storeValue((char)0, store, record, x, offset);           ++x; continue;
+            case FT_NA_FLOAT:   storeValue((float)0.0f, store, record, x, offset);       ++x; continue;
+            case FT_NA_POINTER: storeValue((char const*)nullptr, store, record, x, offset); ++x; continue;
+            default:
+                break;
+        }
 
-        char* record = store.createRecord(fields[0].GetUInt32());
-        offset = 0;
+        // It is required that the input has at least as many columns set as the output requires
+        if (y >= store.GetSrcFieldCount())
+            assert(false && "SQL storage has too few columns!");
 
-        // dependend on dest-size
-        // iterate two indexes: x over dest, y over source
-        //                      y++ If and only If x != FT_NA*
-        //                      x++ If and only If a value is stored
-        for (uint32 x = 0, y = 0; x < store.GetDstFieldCount();)
+        switch (store.GetSrcFormat(y))
         {
-            switch (store.GetDstFormat(x))
-            {
-                // For default fill continue and do not increase y
-                case FT_NA:         storeValue((uint32)0, store, record, x, offset);         ++x; continue;
-                case FT_NA_BYTE:    storeValue((char)0, store, record, x, offset);           ++x; continue;
-                case FT_NA_FLOAT:   storeValue((float)0.0f, store, record, x, offset);       ++x; continue;
-                case FT_NA_POINTER: storeValue((char const*)nullptr, store, record, x, offset); ++x; continue;
-                default:
-                    break;
-            }
-
-            // It is required that the input has at least as many columns set as the output requires
-            if (y >= store.GetSrcFieldCount())
-                assert(false && "SQL storage has too few columns!");
-
-            switch (store.GetSrcFormat(y))
-            {
-                case FT_LOGIC:  storeValue((bool)(fields[y].GetUInt32() > 0), store, record, x, offset);  ++x; break;
-                case FT_BYTE:   storeValue((char)fields[y].GetUInt8(), store, record, x, offset);         ++x; break;
-                case FT_INT:    storeValue((uint32)fields[y].GetUInt32(), store, record, x, offset);      ++x; break;
-                case FT_FLOAT:  storeValue((float)fields[y].GetFloat(), store, record, x, offset);        ++x; break;
-                case FT_STRING: storeValue((char const*)fields[y].GetString(), store, record, x, offset); ++x; break;
-                case FT_64BITINT: storeValue(fields[y].GetUInt64(), store, record, x, offset);            ++x; break;
-                case FT_NA:
-                case FT_NA_BYTE:
-                case FT_NA_FLOAT:
-                    // Do Not increase x
-                    break;
-                case FT_IND:
-                case FT_SORT:
-                case FT_NA_POINTER:
-                    assert(false && "SQL storage not have sort or pointer field types");
-                    break;
-                default:
-                    assert(false && "unknown format character");
-            }
-            ++y;
+            case FT_LOGIC:  storeValue((bool)(row.GetUInt32(y) > 0), store, record, x, offset);  ++x; break;
+            case FT_BYTE:   storeValue((char)uint8(row.GetUInt32(y)), store, record, x, offset); ++x; break;
+            case FT_INT:    storeValue((uint32)row.GetUInt32(y), store, record, x, offset);      ++x; break;
+            case FT_FLOAT:  storeValue((float)row.GetFloat(y), store, record, x, offset);        ++x; break;
+            case FT_STRING: storeValue((char const*)row.GetString(y), store, record, x, offset); ++x; break;
+            case FT_64BITINT: storeValue(row.GetUInt64(y), store, record, x, offset);            ++x; break;
+            case FT_NA:
+            case FT_NA_BYTE:
+            case FT_NA_FLOAT:
+                // Do Not increase x
+                break;
+            case FT_IND:
+            case FT_SORT:
+            case FT_NA_POINTER:
+                assert(false && "SQL storage not have sort or pointer field types");
+                break;
+            default:
+                assert(false && "unknown format character");
         }
+        ++y;
     }
-    while (result->NextRow());
-
-    delete result;
 }
 
 #endif
@@ -20,6 +20,8 @@
 #include "Database/SqlOperations.h"
 #include "DatabaseEnv.h"
 
+#include <chrono>
+
 SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_dbEngine(db), m_dbConnection(conn), m_running(true)
 {
 }
@@ -36,25 +38,35 @@ void SqlDelayThread::run()
     mysql_thread_init();
 #endif
 
-    const uint32 loopSleepms = 10;
-
-    const uint32 pingEveryLoop = m_dbEngine->GetPingIntervall() / loopSleepms;
+    const std::chrono::milliseconds pingInterval(m_dbEngine->GetPingIntervall());
+    std::chrono::steady_clock::time_point nextPing = std::chrono::steady_clock::now() + pingInterval;
 
-    uint32 loopCounter = 0;
+    std::unique_lock<std::mutex> guard(m_queueMutex);
     while (m_running)
     {
-        // if the running state gets turned off while sleeping
-        // empty the queue before exiting
-        MaNGOS::Thread::Sleep(loopSleepms);
+        // sleep until statements arrive, the thread is stopped or the connections need a ping
+        auto const wakeUp = [this] { return !m_running || !m_sqlQueue.empty(); };
+        if (pingInterval.count())
+            m_queueCondition.wait_until(guard, nextPing, wakeUp);
+        else
+            m_queueCondition.wait(guard, wakeUp);
+
+        // execute without the lock, callers must not wait for the database to queue more statements
+        std::queue<std::unique_ptr<SqlOperation>> sqlQueue;
+        sqlQueue.swap(m_sqlQueue);
+        guard.unlock();
 
-        ProcessRequests();
+        ProcessRequests(sqlQueue);
 
-        if ((loopCounter++) >= pingEveryLoop)
+        if (pingInterval.count() && std::chrono::steady_clock::now() >= nextPing)
         {
-            loopCounter = 0;
+            nextPing = std::chrono::steady_clock::now() + pingInterval;
             m_dbEngine->Ping();
         }
+
+        guard.lock();
     }
+    guard.unlock();
 
 #ifndef DO_POSTGRESQL
     mysql_thread_end();
@@ -63,7 +75,11 @@ void SqlDelayThread::run()
 
 void SqlDelayThread::Stop()
 {
-    m_running = false;
+    {
+        std::lock_guard<std::mutex> guard(m_queueMutex);
+        m_running = false;
+    }
+    m_queueCondition.notify_all();
 }
 
 void SqlDelayThread::ProcessRequests()
@@ -77,6 +93,11 @@ void SqlDelayThread::ProcessRequests()
         sqlQueue = std::move(m_sqlQueue);
     }
 
+    ProcessRequests(sqlQueue);
+}
+
+void SqlDelayThread::ProcessRequests(std::queue<std::unique_ptr<SqlOperation>>& sqlQueue)
+{
     while (!sqlQueue.empty())
     {
         auto const s = std::move(sqlQueue.front());
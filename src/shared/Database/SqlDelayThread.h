@@ -15,7 +15,6 @@
  * along with this program; if not, write to the Free Software
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
-
 #ifndef __SQLDELAYTHREAD_H
 #define __SQLDELAYTHREAD_H
 
@@ -23,6 +22,7 @@
 #include "SqlOperations.h"
 
 #include <mutex>
+#include <condition_variable>
 #include <queue>
 #include <memory>
 
@@ -34,13 +34,15 @@ class SqlDelayThread : public MaNGOS::Runnable
 {
     private:
         std::mutex m_queueMutex;
+        std::condition_variable m_queueCondition;               ///< Signaled on new statements and on stop
         std::queue<std::unique_ptr<SqlOperation>> m_sqlQueue;   ///< Queue of SQL statements
         Database* m_dbEngine;                                   ///< Pointer to used Database engine
         SqlConnection* m_dbConnection;                          ///< Pointer to DB connection
-        volatile bool m_running;
+        bool m_running;                                         ///< Guarded by m_queueMutex
 
         // process all enqueued requests
         void ProcessRequests();
+        void ProcessRequests(std::queue<std::unique_ptr<SqlOperation>>& sqlQueue);
 
     public:
         SqlDelayThread(Database* db, SqlConnection* conn);
@@ -49,8 +51,11 @@ class SqlDelayThread : public MaNGOS::Runnable
         ///< Put sql statement to delay queue
         bool Delay(SqlOperation* sql)
         {
-            std::lock_guard<std::mutex> guard(m_queueMutex);
-            m_sqlQueue.push(std::unique_ptr<SqlOperation>(sql));
+            {
+                std::lock_guard<std::mutex> guard(m_queueMutex);
+                m_sqlQueue.push(std::unique_ptr<SqlOperation>(sql));
+            }
+            m_queueCondition.notify_one();
             return true;
         }
 
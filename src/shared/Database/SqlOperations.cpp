@@ -84,12 +84,23 @@ bool SqlPreparedRequest::Execute(SqlConnection* conn)
 
 bool SqlQuery::Execute(SqlConnection* conn)
 {
-    if (!m_callback || !m_queue)
+    if (!m_callback)
         return false;
 
-    LOCK_DB_CONN(conn);
-    /// execute the query and store the result in the callback
-    m_callback->SetResult(conn->Query(&m_sql[0]));
+    {
+        LOCK_DB_CONN(conn);
+        /// execute the query and store the result in the callback
+        m_callback->SetResult(conn->Query(&m_sql[0]));
+    }
+
+    /// without a result queue the callback is called right here, on the delay thread
+    if (!m_queue)
+    {
+        std::unique_ptr<MaNGOS::IQueryCallback> callback(m_callback);
+        callback->Execute();
+        return true;
+    }
+
     /// add the callback to the sql result queue of the thread it originated from
     m_queue->Add(m_callback);
 
@@ -135,10 +146,10 @@ bool SqlQueryHolder::SetQuery(size_t index, const char* sql)
         return false;
     }
 
-    if (m_queries[index].first != nullptr)
+    if (m_queries[index].first != nullptr || m_stmts[index].second != nullptr)
     {
         sLog.outError("Attempt assign query to holder index (" SIZEFMTD ") where other query stored (Old: [%s] New: [%s])",
-                      index, m_queries[index].first, sql);
+                      index, m_queries[index].first ? m_queries[index].first : "<statement>", sql);
         return false;
     }
 
@@ -170,6 +181,28 @@ bool SqlQueryHolder::SetPQuery(size_t index, const char* format, ...)
     return SetQuery(index, szQuery);
 }
 
+bool SqlQueryHolder::SetStmtQuery(size_t index, SqlStatement& stmt)
+{
+    SqlStmtParameters* params = stmt.detach();
+    if (m_queries.size() <= index || params->boundParams() != stmt.arguments())
+    {
+        sLog.outError("Statement query index (" SIZEFMTD ") out of range (size: " SIZEFMTD ") or wrong amount of parameters (%u instead of %u)",
+                      index, m_queries.size(), params->boundParams(), stmt.arguments());
+        delete params;
+        return false;
+    }
+
+    if (m_queries[index].first != nullptr || m_stmts[index].second != nullptr)
+    {
+        sLog.outError("Attempt assign statement query to holder index (" SIZEFMTD ") where other query stored", index);
+        delete params;
+        return false;
+    }
+
+    m_stmts[index] = SqlStmtPair(stmt.ID(), params);
+    return true;
+}
+
 QueryResult* SqlQueryHolder::GetResult(size_t index)
 {
     if (index < m_queries.size())
@@ -180,6 +213,11 @@ QueryResult* SqlQueryHolder::GetResult(size_t index)
             delete[](const_cast<char*>(m_queries[index].first));
             m_queries[index].first = nullptr;
         }
+        if (m_stmts[index].second != nullptr)
+        {
+            delete m_stmts[index].second;
+            m_stmts[index].second = nullptr;
+        }
         /// when you get a result aways remember to delete it!
         return m_queries[index].second;
     }
@@ -200,9 +238,10 @@ SqlQueryHolder::~SqlQueryHolder()
     {
         /// if the result was never used, free the resources
         /// results used already (getresult called) are expected to be deleted
-        if (m_queries[i].first != nullptr)
+        if (m_queries[i].first != nullptr || m_stmts[i].second != nullptr)
         {
             delete[](const_cast<char*>(m_queries[i].first));
+            delete m_stmts[i].second;
             delete m_queries[i].second;
         }
     }
@@ -212,6 +251,7 @@ void SqlQueryHolder::SetSize(size_t size)
 {
     /// to optimize push_back, reserve the number of queries about to be executed
     m_queries.resize(size);
+    m_stmts.resize(size, SqlStmtPair(-1, nullptr));
 }
 
 bool SqlQueryHolderEx::Execute(SqlConnection* conn)
@@ -222,11 +262,13 @@ bool SqlQueryHolderEx::Execute(SqlConnection* conn)
     LOCK_DB_CONN(conn);
     /// we can do this, we are friends
     std::vector<SqlQueryHolder::SqlResultPair>& queries = m_holder->m_queries;
+    std::vector<SqlQueryHolder::SqlStmtPair>& stmts = m_holder->m_stmts;
     for (size_t i = 0; i < queries.size(); ++i)
     {
         /// execute all queries in the holder and pass the results
         char const* sql = queries[i].first;
         if (sql) m_holder->SetResult(i, conn->Query(sql));
+        else if (stmts[i].second) m_holder->SetResult(i, conn->QueryStmt(stmts[i].first, *stmts[i].second));
     }
 
     /// sync with the caller thread
@@ -33,6 +33,7 @@ class Database;
 class SqlConnection;
 class SqlDelayThread;
 class SqlStmtParameters;
+class SqlStatement;
 
 class SqlOperation
 {
@@ -122,11 +123,15 @@ class SqlQueryHolder
     private:
         typedef std::pair<const char*, QueryResult*> SqlResultPair;
         std::vector<SqlResultPair> m_queries;
+        typedef std::pair<int, SqlStmtParameters*> SqlStmtPair;
+        std::vector<SqlStmtPair> m_stmts;                   // prepared statement queries, used instead of the text query at the same index
     public:
         SqlQueryHolder() {}
         ~SqlQueryHolder();
         bool SetQuery(size_t index, const char* sql);
         bool SetPQuery(size_t index, const char* format, ...) ATTR_PRINTF(3, 4);
+        // takes the parameters bound to stmt, the result is fetched in binary protocol
+        bool SetStmtQuery(size_t index, SqlStatement& stmt);
         void SetSize(size_t size);
         QueryResult* GetResult(size_t index);
         void SetResult(size_t index, QueryResult* result);
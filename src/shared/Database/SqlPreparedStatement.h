@@ -206,6 +206,10 @@ class SqlStatement
 
         bool Execute();
         bool DirectExecute();
+        // synchronous SELECT on a query connection, nullptr if there are no rows
+        QueryResult* Query();
+        // synchronous SELECT read row by row from the server, see Database::StreamQuery
+        QueryResult* StreamQuery();
 
         // templates to simplify 1-4 parameter bindings
         template<typename ParamType1>
@@ -242,6 +246,40 @@ class SqlStatement
             return Execute();
         }
 
+        template<typename ParamType1>
+        QueryResult* PQuery(ParamType1 param1)
+        {
+            arg(param1);
+            return Query();
+        }
+
+        template<typename ParamType1, typename ParamType2>
+        QueryResult* PQuery(ParamType1 param1, ParamType2 param2)
+        {
+            arg(param1);
+            arg(param2);
+            return Query();
+        }
+
+        template<typename ParamType1, typename ParamType2, typename ParamType3>
+        QueryResult* PQuery(ParamType1 param1, ParamType2 param2, ParamType3 param3)
+        {
+            arg(param1);
+            arg(param2);
+            arg(param3);
+            return Query();
+        }
+
+        template<typename ParamType1, typename ParamType2, typename ParamType3, typename ParamType4>
+        QueryResult* PQuery(ParamType1 param1, ParamType2 param2, ParamType3 param3, ParamType4 param4)
+        {
+            arg(param1);
+            arg(param2);
+            arg(param3);
+            arg(param4);
+            return Query();
+        }
+
         // bind parameters with specified type
         void addBool(bool var) { arg(var); }
         void addUInt8(uint8 var) { arg(var); }
@@ -261,6 +299,7 @@ class SqlStatement
     protected:
         // don't allow anyone except Database class to create static SqlStatement objects
         friend class Database;
+        friend class SqlQueryHolder;
         SqlStatement(const SqlStatementID& index, Database& db) : m_index(index), m_pDB(&db), m_pParams(nullptr) {}
 
     private:
@@ -314,6 +353,12 @@ class SqlPreparedStatement
 
         // execute statement w/o result set
         virtual bool execute() = 0;
+        // execute query statement, the whole result set is fetched before returning
+        // so the statement can be reused while the result is still read
+        virtual QueryResult* query() = 0;
+        // execute query statement, rows are fetched while the result is read
+        // and the connection stays busy until the result is deleted
+        virtual QueryResult* queryStream() { return query(); }
 
     protected:
         SqlPreparedStatement(const std::string& fmt, SqlConnection& conn) :
@@ -343,6 +388,8 @@ class SqlPlainPreparedStatement : public SqlPreparedStatement
         virtual void bind(const SqlStmtParameters& holder) override;
 
         virtual bool execute() override;
+        virtual QueryResult* query() override;
+        virtual QueryResult* queryStream() override;
 
     protected:
         void DataToString(const SqlStmtFieldData& data, std::ostringstream& fmt) const;
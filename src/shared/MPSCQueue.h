@@ -0,0 +1,129 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MPSCQUEUE_H
+#define MANGOS_MPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace MaNGOS
+{
+    /**
+     * Unbounded lock-free queue for many producer threads and a single consumer thread.
+     *
+     * Producers only swap the head pointer and link the previous node, so they never wait
+     * on each other or on the consumer. Dequeue() must only be called from one thread at a
+     * time and may report the queue empty while a producer is between these two steps; the
+     * element becomes visible on a later call.
+     *
+     * T must be default constructible and movable.
+     */
+    template<typename T>
+    class MPSCQueue
+    {
+        public:
+            MPSCQueue() : m_head(new Node()), m_size(0) { m_tail = m_head.load(std::memory_order_relaxed); }
+            ~MPSCQueue()
+            {
+                T element;
+                while (Dequeue(element)) {}
+                delete m_tail;
+            }
+
+            MPSCQueue(MPSCQueue const&) = delete;
+            MPSCQueue& operator=(MPSCQueue const&) = delete;
+
+            void Enqueue(T&& element)
+            {
+                m_size.fetch_add(1, std::memory_order_relaxed);
+                Link(new Node(std::move(element)));
+            }
+
+            // enqueue unless the queue already holds limit elements (0 means no limit)
+            bool TryEnqueue(T&& element, size_t limit)
+            {
+                if (limit && m_size.fetch_add(1, std::memory_order_relaxed) >= limit)
+                {
+                    m_size.fetch_sub(1, std::memory_order_relaxed);
+                    return false;
+                }
+
+                if (!limit)
+                    m_size.fetch_add(1, std::memory_order_relaxed);
+
+                Link(new Node(std::move(element)));
+                return true;
+            }
+
+            // consumer thread only
+            bool Dequeue(T& element)
+            {
+                Node* tail = m_tail;
+                Node* next = tail->next.load(std::memory_order_acquire);
+                if (!next)
+                    return false;
+
+                // next becomes the new stub node
+                element = std::move(next->data);
+                m_tail = next;
+                delete tail;
+
+                m_size.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+
+            // consumer thread only, dequeues the next element only if check accepts it
+            template<class Checker>
+            bool DequeueIf(T& element, Checker const& check)
+            {
+                Node* next = m_tail->next.load(std::memory_order_acquire);
+                if (!next || !check(next->data))
+                    return false;
+
+                return Dequeue(element);
+            }
+
+            // approximate while producers are active
+            size_t Size() const { return m_size.load(std::memory_order_relaxed); }
+            bool Empty() const { return Size() == 0; }
+
+        private:
+            struct Node
+            {
+                Node() : next(nullptr) {}
+                explicit Node(T&& element) : data(std::move(element)), next(nullptr) {}
+
+                T data;
+                std::atomic<Node*> next;
+            };
+
+            void Link(Node* node)
+            {
+                Node* prev = m_head.exchange(node, std::memory_order_acq_rel);
+                prev->next.store(node, std::memory_order_release);
+            }
+
+            std::atomic<Node*> m_head;                          // last enqueued node, shared by producers
+            Node* m_tail;                                       // stub node before the next element, consumer only
+            std::atomic<size_t> m_size;
+    };
+}
+
+#endif
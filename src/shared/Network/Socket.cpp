@@ -31,9 +31,26 @@
 
 namespace MaNGOS
 {
+std::atomic<uint64> Socket::s_flushes(0);
+std::atomic<uint64> Socket::s_flushDelay(0);
+std::atomic<uint64> Socket::s_sends(0);
+std::atomic<uint64> Socket::s_bytesSent(0);
+
 Socket::Socket(boost::asio::io_service &service, std::function<void (Socket *)> closeHandler)
-    : m_writeState(WriteState::Idle), m_readState(ReadState::Idle), m_socket(service),
-      m_closeHandler(closeHandler), m_outBufferFlushTimer(service), m_address("0.0.0.0") {}
+    : m_writeState(WriteState::Idle), m_readState(ReadState::Idle), m_service(service), m_socket(service),
+      m_closeHandler(closeHandler), m_outQueueSending(0), m_outQueueBuffered(0),
+      m_outBufferFlushTimer(service), m_bufferTimeout(DefaultBufferTimeout),
+      m_flushThreshold(0), m_address("0.0.0.0") {}
+
+Socket::WriteStatistics Socket::GetWriteStatistics()
+{
+    WriteStatistics stats;
+    stats.flushes = s_flushes;
+    stats.flushDelay = s_flushDelay;
+    stats.sends = s_sends;
+    stats.bytesSent = s_bytesSent;
+    return stats;
+}
 
 bool Socket::Open()
 {
@@ -48,8 +65,6 @@ bool Socket::Open()
         return false;
     }
 
-    m_outBuffer.reset(new PacketBuffer);
-    m_secondaryOutBuffer.reset(new PacketBuffer);
     m_inBuffer.reset(new PacketBuffer);
 
     StartAsyncRead();
@@ -166,19 +181,60 @@ void Socket::Write(const char *buffer, int length)
 {
     std::lock_guard<std::mutex> guard(m_mutex);
 
+    // append to the last copied segment unless it is part of the running send
+    if (m_outQueue.size() <= m_outQueueSending || m_outQueue.back().shared)
+    {
+        m_outQueue.emplace_back();
+        m_outQueue.back().copied.swap(m_spareSegment);
+    }
+
+    std::vector<uint8>& segment = m_outQueue.back().copied;
+    segment.insert(segment.end(), reinterpret_cast<const uint8*>(buffer), reinterpret_cast<const uint8*>(buffer) + length);
+    m_outQueueBuffered += length;
+
+    OnBuffered();
+}
+
+void Socket::Write(SharedBuffer const& buffer)
+{
+    if (buffer->empty())
+        return;
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    m_outQueue.emplace_back();
+    m_outQueue.back().shared = buffer;
+    m_outQueueBuffered += buffer->size();
+
+    OnBuffered();
+}
+
+// note that this function assumes that the socket mutex is locked
+void Socket::OnBuffered()
+{
     switch (m_writeState)
     {
         case WriteState::Idle:
-            m_outBuffer->Write(buffer, length);
-            StartWriteFlushTimer();
+            if (ShouldFlushNow())
+            {
+                m_bufferStart = std::chrono::steady_clock::now();
+                StartSend();
+            }
+            else
+                StartWriteFlushTimer();
             break;
 
         case WriteState::Buffering:
-            m_outBuffer->Write(buffer, length);
+            // the pending timer finds the socket no longer buffering and does nothing
+            if (ShouldFlushNow())
+            {
+                m_outBufferFlushTimer.cancel();
+                StartSend();
+            }
             break;
 
         case WriteState::Sending:
-            m_secondaryOutBuffer->Write(buffer, length);
+            // everything queued meanwhile goes out when the send completes
             break;
 
         default:
@@ -200,12 +256,19 @@ void Socket::StartWriteFlushTimer()
     }
 
     m_writeState = WriteState::Buffering;
+    m_bufferStart = std::chrono::steady_clock::now();
 
     std::shared_ptr<Socket> ptr = shared<Socket>();
-    m_outBufferFlushTimer.expires_from_now(boost::posix_time::milliseconds(BufferTimeout));
+    m_outBufferFlushTimer.expires_from_now(boost::posix_time::milliseconds(m_bufferTimeout.load()));
     m_outBufferFlushTimer.async_wait([ptr](const boost::system::error_code &error) { ptr->FlushOut(); });
 }
 
+// note that this function assumes that the socket mutex is locked
+bool Socket::ShouldFlushNow() const
+{
+    return !m_bufferTimeout || (m_flushThreshold && m_outQueueBuffered >= m_flushThreshold);
+}
+
 void Socket::FlushOut()
 {
     // if the socket is closed, silently fail
@@ -217,13 +280,45 @@ void Socket::FlushOut()
 
     std::lock_guard<std::mutex> guard(m_mutex);
 
-    assert(m_writeState == WriteState::Buffering);
+    // a write may have reached the flush threshold and sent the buffer before the timer expired
+    if (m_writeState != WriteState::Buffering)
+        return;
+
+    StartSend();
+}
+
+// note that this function assumes that the socket mutex is locked
+void Socket::StartSend()
+{
+    // if the socket is closed, silently fail
+    if (IsClosed())
+    {
+        m_writeState = WriteState::Idle;
+        return;
+    }
+
+    ++s_flushes;
+    s_flushDelay += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_bufferStart).count();
 
-    // at this point we are guarunteed that there is data to send in the primary buffer.  send it.
     m_writeState = WriteState::Sending;
+    SendQueued();
+}
+
+// note that this function assumes that the socket mutex is locked
+void Socket::SendQueued()
+{
+    // at this point we are guarunteed that there is data to send in the queue.  send all of it in one gathered write,
+    // shared buffers are referenced directly instead of being copied into a socket buffer first
+    m_sendBuffers.clear();
+    for (std::deque<OutSegment>::const_iterator itr = m_outQueue.begin(); itr != m_outQueue.end(); ++itr)
+        m_sendBuffers.push_back(boost::asio::buffer(itr->Data(), itr->Size()));
+
+    m_outQueueSending = m_outQueue.size();
+    m_outQueueBuffered = 0;
+    ++s_sends;
 
     std::shared_ptr<Socket> ptr = shared<Socket>();
-    m_socket.async_write_some(boost::asio::buffer(m_outBuffer->m_buffer, m_outBuffer->m_writePosition),
+    boost::asio::async_write(m_socket, m_sendBuffers,
         make_custom_alloc_handler(m_allocator,
             [ptr](const boost::system::error_code &error, size_t length) { ptr->OnWriteComplete(error, length); }));
 }
@@ -255,37 +350,25 @@ void Socket::OnWriteComplete(const boost::system::error_code &error, size_t leng
     std::lock_guard<std::mutex> guard(m_mutex);
 
     assert(m_writeState == WriteState::Sending);
-    assert(length <= m_outBuffer->m_writePosition);
+    assert(m_outQueueSending <= m_outQueue.size());
 
-    // if there is data left to write, move it to the start of the buffer
-    if (length < m_outBuffer->m_writePosition)
-    {
-        std::copy(&m_outBuffer->m_buffer[length], &m_outBuffer->m_buffer[m_outBuffer->m_writePosition], m_outBuffer->m_buffer.begin());
-        m_outBuffer->m_writePosition -= length;
-    }
-    // if not, reset the write pointer
-    else
-        m_outBuffer->m_writePosition = 0;
+    s_bytesSent += length;
 
-    // if there is data in the secondary buffer, append it to the primary buffer
-    if (m_secondaryOutBuffer->m_writePosition > 0)
+    // async_write only completes once everything was written, drop the sent segments
+    for (; m_outQueueSending; --m_outQueueSending)
     {
-        // do we have enough space? if not, resize
-        if (m_outBuffer->m_buffer.size() < (m_outBuffer->m_writePosition + m_secondaryOutBuffer->m_writePosition))
-            m_outBuffer->m_buffer.resize(m_outBuffer->m_writePosition + m_secondaryOutBuffer->m_writePosition);
-
-        std::copy(&m_secondaryOutBuffer->m_buffer[0], &m_secondaryOutBuffer->m_buffer[m_secondaryOutBuffer->m_writePosition], &m_outBuffer->m_buffer[m_outBuffer->m_writePosition]);
-
-        m_outBuffer->m_writePosition += m_secondaryOutBuffer->m_writePosition;
-        m_secondaryOutBuffer->m_writePosition = 0;
+        OutSegment& segment = m_outQueue.front();
+        if (!segment.shared && segment.copied.capacity() > m_spareSegment.capacity() && segment.copied.capacity() <= MaxSpareSegmentSize)
+        {
+            segment.copied.clear();
+            m_spareSegment.swap(segment.copied);
+        }
+        m_outQueue.pop_front();
     }
 
-    std::shared_ptr<Socket> ptr = shared<Socket>();
     // if there is any data to write, do so immediately
-    if (m_outBuffer->m_writePosition > 0)
-        m_socket.async_write_some(boost::asio::buffer(m_outBuffer->m_buffer, m_outBuffer->m_writePosition),
-            make_custom_alloc_handler(m_allocator,
-                [ptr](const boost::system::error_code &error, size_t length) { ptr->OnWriteComplete(error, length);}));
+    if (!m_outQueue.empty())
+        SendQueued();
     else
         m_writeState = WriteState::Idle;
 }
@@ -22,22 +22,45 @@
 #include "PacketBuffer.hpp"
 
 #include "Platform/Define.h"
+#include "ByteBuffer.h"
 
 #include <boost/asio.hpp>
 
 #include <memory>
 #include <string>
+#include <deque>
+#include <vector>
 #include <mutex>
+#include <atomic>
+#include <chrono>
 #include <functional>
 
 namespace MaNGOS
 {
     class Socket : public std::enable_shared_from_this<Socket>
     {
+        public:
+            // totals over all sockets since startup
+            struct WriteStatistics
+            {
+                uint64 flushes;         // buffered writes handed to the network, one per coalescing window
+                uint64 flushDelay;      // sum of the time data waited in the buffer before its flush, in microseconds
+                uint64 sends;           // vectored async writes of all queued segments
+                uint64 bytesSent;
+            };
+
+            static WriteStatistics GetWriteStatistics();
+
+            // immutable buffer which may be queued on any number of sockets without copying
+            typedef std::shared_ptr<ByteBuffer const> SharedBuffer;
+
         private:
-            // buffer timeout period, in milliseconds.  higher values decrease responsiveness
+            // default buffer timeout period, in milliseconds.  higher values decrease responsiveness
             // ingame but increase bandwidth efficiency by reducing tcp overhead.
-            static const int BufferTimeout = 50;
+            static const uint32 DefaultBufferTimeout = 50;
+
+            // larger copy buffers are released after sending instead of being kept for reuse
+            static const size_t MaxSpareSegmentSize = 65536;
 
             enum class WriteState
             {
@@ -55,23 +78,51 @@ namespace MaNGOS
             WriteState m_writeState;
             ReadState m_readState;
 
+            boost::asio::io_service& m_service;
             boost::asio::ip::tcp::socket m_socket;
 
             std::function<void(Socket *)> m_closeHandler;
 
             std::unique_ptr<PacketBuffer> m_inBuffer;
-            std::unique_ptr<PacketBuffer> m_outBuffer;
-            std::unique_ptr<PacketBuffer> m_secondaryOutBuffer;
+
+            // one piece of the output, either bytes copied by Write() or a referenced shared buffer
+            struct OutSegment
+            {
+                std::vector<uint8> copied;
+                SharedBuffer shared;
+
+                const uint8* Data() const { return shared ? shared->contents() : copied.data(); }
+                size_t Size() const { return shared ? shared->size() : copied.size(); }
+            };
+
+            std::deque<OutSegment> m_outQueue;                  // element references stay valid while writes are appended
+            size_t m_outQueueSending;                           // number of segments at the front handed to the running send
+            size_t m_outQueueBuffered;                          // bytes queued behind them, not yet sending
+            std::vector<uint8> m_spareSegment;                  // storage of a sent segment, reused for the next copy
+            std::vector<boost::asio::const_buffer> m_sendBuffers;
 
             std::mutex m_mutex;
             boost::asio::deadline_timer m_outBufferFlushTimer;
 
+            std::atomic<uint32> m_bufferTimeout;                // current coalescing window in milliseconds, 0 sends every write at once
+            size_t m_flushThreshold;                            // buffered bytes which trigger a send before the timer expires, 0 for no limit
+            std::chrono::steady_clock::time_point m_bufferStart;
+
+            static std::atomic<uint64> s_flushes;
+            static std::atomic<uint64> s_flushDelay;
+            static std::atomic<uint64> s_sends;
+            static std::atomic<uint64> s_bytesSent;
+
             void StartAsyncRead();
             void OnRead(const boost::system::error_code &error, size_t length);
 
             void StartWriteFlushTimer();
             void OnWriteComplete(const boost::system::error_code &error, size_t length);
             void FlushOut();
+            void StartSend();
+            void SendQueued();
+            bool ShouldFlushNow() const;
+            void OnBuffered();
 
             void OnError(const boost::system::error_code &error);
 
@@ -87,6 +138,14 @@ namespace MaNGOS
 
             void ForceFlushOut();
 
+            void SetBufferTimeout(uint32 milliseconds) { m_bufferTimeout = milliseconds; }
+            uint32 GetBufferTimeout() const { return m_bufferTimeout; }
+            void SetFlushThreshold(size_t bytes) { m_flushThreshold = bytes; }
+
+            // queues the handler to run on the network thread owning this socket, may be called from any thread
+            template <typename Handler>
+            void Post(Handler handler) { m_service.post(handler); }
+
         public:
             Socket(boost::asio::io_service &service, std::function<void (Socket *)> closeHandler);
             virtual ~Socket() = default;
@@ -101,6 +160,7 @@ namespace MaNGOS
             void ReadSkip(int length) { m_inBuffer->Read(nullptr, length); }
 
             void Write(const char *buffer, int length);
+            void Write(SharedBuffer const& buffer);
 
             boost::asio::ip::tcp::socket &GetAsioSocket() { return m_socket; }
 
@@ -37,10 +37,10 @@
 // Format is YYYYMMDDRR where RR is the change in the conf file
 // for that day.
 #ifndef _MANGOSDCONFVERSION
-# define _MANGOSDCONFVERSION 2016101401
+# define _MANGOSDCONFVERSION 2026101812
 #endif
 #ifndef _REALMDCONFVERSION
-# define _REALMDCONFVERSION 2010062001
+# define _REALMDCONFVERSION 2026101801
 #endif
 
 #if MANGOS_ENDIAN == MANGOS_BIGENDIAN
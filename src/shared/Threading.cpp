@@ -135,3 +135,87 @@ void Thread::Sleep(unsigned long msecs)
 {
     std::this_thread::sleep_for(std::chrono::milliseconds(msecs));
 }
+
+ThreadPool::ThreadPool(unsigned int numThreads) : m_cancel(false)
+{
+    m_threads.reserve(numThreads);
+    for (unsigned int i = 0; i < numThreads; ++i)
+        m_threads.emplace_back(&ThreadPool::WorkerThread, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_cancel = true;
+    }
+    m_taskCondition.notify_all();
+
+    for (std::vector<std::thread>::iterator itr = m_threads.begin(); itr != m_threads.end(); ++itr)
+        itr->join();
+}
+
+void ThreadPool::Enqueue(TaskGroup& group, Task task)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        QueuedTask queued = { &group, std::move(task) };
+        m_tasks.push_back(std::move(queued));
+        ++group.m_pending;
+    }
+    m_taskCondition.notify_one();
+}
+
+void ThreadPool::Wait(TaskGroup& group)
+{
+    std::unique_lock<std::mutex> guard(m_lock);
+    while (group.m_pending)
+    {
+        if (m_tasks.empty())
+        {
+            m_finishedCondition.wait(guard);
+            continue;
+        }
+
+        QueuedTask task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+
+        guard.unlock();
+        Execute(task);
+        guard.lock();
+    }
+}
+
+void ThreadPool::WorkerThread()
+{
+    for (;;)
+    {
+        QueuedTask task;
+        {
+            std::unique_lock<std::mutex> guard(m_lock);
+            m_taskCondition.wait(guard, [this] { return m_cancel || !m_tasks.empty(); });
+
+            // only reached with an empty queue on shutdown
+            if (m_tasks.empty())
+                return;
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+
+        Execute(task);
+    }
+}
+
+void ThreadPool::Execute(QueuedTask& task)
+{
+    task.task();
+
+    bool finished;
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        finished = --task.group->m_pending == 0;
+    }
+    if (finished)
+        m_finishedCondition.notify_all();
+}
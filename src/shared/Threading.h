@@ -21,6 +21,11 @@
 
 #include <thread>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <vector>
 
 namespace MaNGOS
 {
@@ -76,5 +81,61 @@ namespace MaNGOS
             std::thread::id m_iThreadId;
             std::thread m_ThreadImp;
     };
+
+    /**
+     * Fixed set of worker threads executing queued tasks.
+     *
+     * Tasks are queued for a TaskGroup and the caller waits for the whole group.
+     * A thread waiting for a group executes queued tasks itself meanwhile, so a pool
+     * can be shared by several callers without them blocking each other.
+     */
+    class ThreadPool
+    {
+        public:
+            typedef std::function<void()> Task;
+
+            class TaskGroup
+            {
+                    friend class ThreadPool;
+
+                public:
+                    TaskGroup() : m_pending(0) {}
+
+                private:
+                    TaskGroup(const TaskGroup&);
+                    TaskGroup& operator=(const TaskGroup&);
+
+                    unsigned int m_pending;                 // guarded by the pool lock
+            };
+
+            explicit ThreadPool(unsigned int numThreads);
+            ~ThreadPool();
+
+            void Enqueue(TaskGroup& group, Task task);
+            void Wait(TaskGroup& group);
+
+            unsigned int GetThreadCount() const { return m_threads.size(); }
+
+        private:
+            ThreadPool(const ThreadPool&);
+            ThreadPool& operator=(const ThreadPool&);
+
+            struct QueuedTask
+            {
+                TaskGroup* group;
+                Task task;
+            };
+
+            void WorkerThread();
+            void Execute(QueuedTask& task);
+
+            std::vector<std::thread> m_threads;
+
+            std::mutex m_lock;
+            std::condition_variable m_taskCondition;        // signaled when a task is queued or on shutdown
+            std::condition_variable m_finishedCondition;    // signaled when a task group is done
+            std::deque<QueuedTask> m_tasks;
+            bool m_cancel;
+    };
 }
 #endif
\ No newline at end of file